@@ -0,0 +1,175 @@
+# Build-time tables shared by the IDF and host builds of the engine. All of
+# them derive from words/<length>/answers.txt and allowed.txt, once for every
+# length in WORDLE_WORD_LENGTHS the caller sets, into symbols suffixed with the
+# length so that all of them link side by side.
+set(WORDLE_ENGINE_DIR ${CMAKE_CURRENT_LIST_DIR})
+set(WORDLE_GEN_DIR ${CMAKE_CURRENT_BINARY_DIR}/gen)
+
+# Word lists for one length, as answers / allowed in the caller
+macro(wordle_word_lists len)
+    if(NOT EXISTS ${WORDLE_ENGINE_DIR}/words/${len}/answers.txt)
+        message(FATAL_ERROR "No word lists for ${len}-letter words in words/${len}")
+    endif()
+    set(answers ${WORDLE_ENGINE_DIR}/words/${len}/answers.txt)
+    set(allowed ${WORDLE_ENGINE_DIR}/words/${len}/allowed.txt)
+endmacro()
+
+# Answer table. Generated at configure time: it is tiny, most sources include
+# its header, and a malformed word should stop the build before anything else.
+# Sets WORDLE_ANSWER_COUNT in the caller's scope.
+function(wordle_words_generate python len)
+    wordle_word_lists(${len})
+    set(tools ${WORDLE_ENGINE_DIR}/tools)
+
+    # Regenerate when the list or the generator changes
+    set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS
+                 ${answers} ${tools}/gen_words.py ${tools}/wordlist.py)
+
+    file(MAKE_DIRECTORY ${WORDLE_GEN_DIR})
+    execute_process(COMMAND ${python} ${tools}/gen_words.py ${answers} --length ${len}
+                            --header ${WORDLE_GEN_DIR}/wordle_words_${len}.h
+                            --source ${WORDLE_GEN_DIR}/wordle_words_${len}.c
+                    OUTPUT_VARIABLE summary
+                    ERROR_VARIABLE error
+                    OUTPUT_STRIP_TRAILING_WHITESPACE
+                    RESULT_VARIABLE result)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "Answer list rejected: ${error}")
+    endif()
+    message(STATUS "Answer list: ${len} letters, ${summary}")
+
+    string(REGEX MATCH "^[0-9]+" count "${summary}")
+    set(WORDLE_ANSWER_COUNT ${count} PARENT_SCOPE)
+endfunction()
+
+# Decides at configure time whether one length's guess x answer feedback
+# matrix fits the flash budget and reports its size. Sets WORDLE_FB_MATRIX
+# (0/1) in the caller's scope. The matrix itself is generated at build time
+# by the caller.
+function(wordle_fb_matrix_setup len words enabled max_kb)
+    # Codes are a byte up to five letters (3^5 = 243), two above
+    set(code_bytes 1)
+    if(len GREATER 5)
+        set(code_bytes 2)
+    endif()
+    math(EXPR bytes "${words} * ${words} * ${code_bytes}")
+    math(EXPR limit "${max_kb} * 1024")
+    if(NOT enabled)
+        set(have 0)
+        set(how "disabled, computed at runtime")
+    elseif(bytes GREATER limit)
+        set(have 0)
+        set(how "over the ${max_kb} KB limit, computed at runtime")
+    else()
+        set(have 1)
+        set(how "embedded in flash")
+    endif()
+    message(STATUS "Feedback matrix, ${len} letters: ${words} x ${words} words = ${bytes} bytes, ${how}")
+    set(WORDLE_FB_MATRIX ${have} PARENT_SCOPE)
+endfunction()
+
+# Build-time command producing one length's feedback matrix, as raw bytes
+# (--bin) or a C array (--c)
+function(wordle_fb_matrix_command python len format output)
+    wordle_word_lists(${len})
+    set(tools ${WORDLE_ENGINE_DIR}/tools)
+    add_custom_command(OUTPUT ${output}
+                       COMMAND ${python} ${tools}/gen_feedback_matrix.py ${answers}
+                               --length ${len} ${format} ${output}
+                       DEPENDS ${answers} ${tools}/gen_feedback_matrix.py ${tools}/wordlist.py
+                       VERBATIM)
+endfunction()
+
+# Generate one length's allowed-guess dictionary source and add it to target
+function(wordle_dict_generate python len target)
+    wordle_word_lists(${len})
+    set(tools ${WORDLE_ENGINE_DIR}/tools)
+    set(dict_c ${WORDLE_GEN_DIR}/wordle_dict_${len}.c)
+
+    add_custom_command(OUTPUT ${dict_c}
+                       COMMAND ${python} ${tools}/gen_dictionary.py ${allowed} ${answers}
+                               --length ${len} --c ${dict_c}
+                       DEPENDS ${allowed} ${answers} ${tools}/gen_dictionary.py ${tools}/wordlist.py
+                       VERBATIM)
+    target_sources(${target} PRIVATE ${dict_c})
+endfunction()
+
+# Generate one length's per-answer difficulty tables the word deck deals from
+# and add them to target. Plays the entropy solver against every answer, about
+# a second of Python.
+function(wordle_difficulty_generate python len target)
+    wordle_word_lists(${len})
+    set(tools ${WORDLE_ENGINE_DIR}/tools)
+    set(difficulty_c ${WORDLE_GEN_DIR}/wordle_difficulty_${len}.c)
+
+    add_custom_command(OUTPUT ${difficulty_c}
+                       COMMAND ${python} ${tools}/gen_difficulty.py ${answers}
+                               --length ${len} --c ${difficulty_c}
+                       DEPENDS ${answers} ${tools}/gen_difficulty.py ${tools}/wordlist.py
+                       VERBATIM)
+    target_sources(${target} PRIVATE ${difficulty_c})
+endfunction()
+
+# Every table of every length in WORDLE_WORD_LENGTHS, one source per length
+# that compiles the per-length modules for it (wordle_variant.c.in), and
+# wordle_variants.h describing the set, all added to target. The caller sets
+# WORDLE_WORD_LENGTHS, WORDLE_WORD_LEN (the default length, one of them) and
+# WORDLE_GUESSES_<length>. Sets WORDLE_FB_MATRIX_LENGTHS, the lengths whose
+# feedback matrix fits, for the caller to generate in its own format.
+function(wordle_variants_generate python target matrix_enabled matrix_max_kb)
+    list(SORT WORDLE_WORD_LENGTHS)
+    list(REMOVE_DUPLICATES WORDLE_WORD_LENGTHS)
+    if(NOT WORDLE_WORD_LEN IN_LIST WORDLE_WORD_LENGTHS)
+        message(FATAL_ERROR "Default word length ${WORDLE_WORD_LEN} is not in WORDLE_WORD_LENGTHS (${WORDLE_WORD_LENGTHS})")
+    endif()
+
+    set(defines "")
+    set(matrix_lengths "")
+    set(index 0)
+    set(WORDLE_MAX_ROWS 0)
+    set(WORDLE_MAX_ANSWERS 0)
+    set(WORDLE_WORD_LEN_MASK 0)
+    foreach(len IN LISTS WORDLE_WORD_LENGTHS)
+        if(NOT WORDLE_GUESSES_${len})
+            message(FATAL_ERROR "WORDLE_GUESSES_${len} is not set")
+        endif()
+        wordle_words_generate(${python} ${len})
+        wordle_fb_matrix_setup(${len} ${WORDLE_ANSWER_COUNT} "${matrix_enabled}" ${matrix_max_kb})
+        if(WORDLE_FB_MATRIX)
+            list(APPEND matrix_lengths ${len})
+        endif()
+        wordle_dict_generate(${python} ${len} ${target})
+        wordle_difficulty_generate(${python} ${len} ${target})
+
+        set(WORDLE_VARIANT_LEN ${len})
+        configure_file(${WORDLE_ENGINE_DIR}/wordle_variant.c.in ${WORDLE_GEN_DIR}/wordle_variant_${len}.c)
+        target_sources(${target} PRIVATE ${WORDLE_GEN_DIR}/wordle_words_${len}.c
+                                         ${WORDLE_GEN_DIR}/wordle_variant_${len}.c)
+
+        string(APPEND defines "#define WORDLE_HAVE_${len}            1\n"
+                              "#define WORDLE_VARIANT_INDEX_${len}   ${index}\n"
+                              "#define WORDLE_GUESSES_${len}         ${WORDLE_GUESSES_${len}}\n"
+                              "#define WORDLE_FB_MATRIX_${len}       ${WORDLE_FB_MATRIX}\n")
+        if(len EQUAL WORDLE_WORD_LEN)
+            set(WORDLE_DEFAULT_VARIANT_INDEX ${index})
+        endif()
+        if(WORDLE_GUESSES_${len} GREATER WORDLE_MAX_ROWS)
+            set(WORDLE_MAX_ROWS ${WORDLE_GUESSES_${len}})
+        endif()
+        if(WORDLE_ANSWER_COUNT GREATER WORDLE_MAX_ANSWERS)
+            set(WORDLE_MAX_ANSWERS ${WORDLE_ANSWER_COUNT})
+        endif()
+        math(EXPR WORDLE_WORD_LEN_MASK "${WORDLE_WORD_LEN_MASK} | (1 << ${len})")
+        math(EXPR index "${index} + 1")
+    endforeach()
+
+    list(LENGTH WORDLE_WORD_LENGTHS WORDLE_VARIANT_COUNT)
+    list(GET WORDLE_WORD_LENGTHS 0 WORDLE_MIN_WORD_LEN)
+    list(GET WORDLE_WORD_LENGTHS -1 WORDLE_MAX_WORD_LEN)
+    set(WORDLE_VARIANT_DEFINES "${defines}")
+    configure_file(${WORDLE_ENGINE_DIR}/wordle_variants.h.in ${WORDLE_GEN_DIR}/wordle_variants.h)
+    message(STATUS "Word lengths: ${WORDLE_WORD_LENGTHS}, rooms default to ${WORDLE_WORD_LEN}")
+
+    target_include_directories(${target} PUBLIC ${WORDLE_GEN_DIR})
+    set(WORDLE_FB_MATRIX_LENGTHS ${matrix_lengths} PARENT_SCOPE)
+endfunction()
@@ -0,0 +1,44 @@
+#ifndef WORDLE_CANDS_H
+#define WORDLE_CANDS_H
+
+#include <stdint.h>
+#include "wordle_feedback.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Answers still consistent with one player's feedback, as a bitset over
+// wordle_answers. A guess's feedback is the AND of a handful of build-time
+// masks (letter at a position or not, at least / exactly k copies of a
+// letter), so an update is a few hundred word operations no matter how many
+// answers are left or which allowed word was guessed.
+// Sized for the longest answer list built; a room only uses the words its
+// own list needs.
+typedef struct {
+    uint32_t bits[WORDLE_MAX_CAND_WORDS];
+} wordle_cands_t;
+
+#ifdef WORDLE_WORD_LEN
+#include "wordle_words.h"
+
+#define wordle_cands_reset  WORDLE_V(wordle_cands_reset)
+#define wordle_cands_apply  WORDLE_V(wordle_cands_apply)
+#define wordle_cands_count  WORDLE_V(wordle_cands_count)
+
+// Every answer is possible again
+void wordle_cands_reset(wordle_cands_t *cands);
+
+// Keep the answers for which guess would have scored code
+void wordle_cands_apply(wordle_cands_t *cands, wordle_word_t guess, wordle_fb_t code);
+
+// Answers left
+int wordle_cands_count(const wordle_cands_t *cands);
+
+#endif // WORDLE_WORD_LEN
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WORDLE_CANDS_H
@@ -0,0 +1,93 @@
+#ifndef WORDLE_DECK_H
+#define WORDLE_DECK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "wordle_feedback.h"
+
+#ifdef ESP_PLATFORM
+#include "sdkconfig.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Word scheduler: the answers split into difficulty tiers at build time, each
+// tier dealt from its own shuffled deck so no word comes back until the whole
+// tier has been played. Drawing is a table read; reshuffling a tier when it
+// runs out is one pass over a third of the list.
+
+#define WORDLE_TIERS 3
+
+typedef enum {
+    WORDLE_TIER_EASY,
+    WORDLE_TIER_MEDIUM,
+    WORDLE_TIER_HARD,
+} wordle_tier_t;
+
+// Which tier each round deals from: 0 rotates easy, medium, hard; 1-3 always
+// deal that tier
+#ifndef CONFIG_WORDLE_DIFFICULTY
+#define CONFIG_WORDLE_DIFFICULTY 0
+#endif
+
+// Where the deck is. The order of every pass follows from the seed, so this is
+// all that needs saving to carry on after a reboot without repeating words.
+typedef struct {
+    uint32_t seed;
+    uint32_t pass[WORDLE_TIERS];   // Times each tier has been shuffled
+    uint16_t dealt[WORDLE_TIERS];  // Cards dealt from the current pass
+} wordle_deck_pos_t;
+
+// One per word length, sized for the longest answer list
+typedef struct {
+    uint16_t cards[WORDLE_MAX_ANSWERS];  // Answer indices, laid out like wordle_tier_answers
+    wordle_deck_pos_t pos;
+} wordle_deck_t;
+
+// Tier for a round (1-based) under CONFIG_WORDLE_DIFFICULTY
+static inline wordle_tier_t wordle_round_tier(int round)
+{
+#if CONFIG_WORDLE_DIFFICULTY == 0
+    return (wordle_tier_t)((unsigned)(round - 1) % WORDLE_TIERS);
+#else
+    (void)round;
+    return (wordle_tier_t)(CONFIG_WORDLE_DIFFICULTY - 1);
+#endif
+}
+
+#ifdef WORDLE_WORD_LEN
+#include "wordle_words.h"
+
+#define wordle_answer_guesses  WORDLE_V(wordle_answer_guesses)
+#define wordle_tier_answers    WORDLE_V(wordle_tier_answers)
+#define wordle_tier_start      WORDLE_V(wordle_tier_start)
+#define wordle_deck_init       WORDLE_V(wordle_deck_init)
+#define wordle_deck_restore    WORDLE_V(wordle_deck_restore)
+#define wordle_deck_draw       WORDLE_V(wordle_deck_draw)
+
+// Generated by gen_difficulty.py: guesses the entropy solver needs for each
+// answer, and answer indices easiest first, tier t being
+// [wordle_tier_start[t], wordle_tier_start[t + 1])
+extern const uint8_t wordle_answer_guesses[WORDLE_ANSWER_COUNT];
+extern const uint16_t wordle_tier_answers[WORDLE_ANSWER_COUNT];
+extern const uint16_t wordle_tier_start[WORDLE_TIERS + 1];
+
+// Shuffle every tier from seed (esp_random() on the device)
+void wordle_deck_init(wordle_deck_t *deck, uint32_t seed);
+
+// Rebuild the deck at a saved position. Returns false, leaving the deck
+// alone, when pos does not fit this answer list.
+bool wordle_deck_restore(wordle_deck_t *deck, const wordle_deck_pos_t *pos);
+
+// Next answer index from a tier, reshuffling the tier once it is used up
+uint16_t wordle_deck_draw(wordle_deck_t *deck, wordle_tier_t tier);
+
+#endif // WORDLE_WORD_LEN
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WORDLE_DECK_H
@@ -0,0 +1,39 @@
+#ifndef WORDLE_DICT_H
+#define WORDLE_DICT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "wordle_feedback.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef WORDLE_WORD_LEN
+
+#define wordle_dict_count     WORDLE_V(wordle_dict_count)
+#define wordle_dict_tree      WORDLE_V(wordle_dict_tree)
+#define wordle_dict_contains  WORDLE_V(wordle_dict_contains)
+
+// Allowed-guess dictionary generated from words/<length>/allowed.txt plus
+// every answer. Packed words (no pointers, no NULs) in Eytzinger order.
+extern const size_t wordle_dict_count;
+extern const wordle_word_entry_t wordle_dict_tree[];
+
+// O(log n) membership test for a packed guess
+bool wordle_dict_contains(wordle_word_t word);
+
+// Flash used by the dictionary table
+static inline size_t wordle_dict_bytes(void)
+{
+    return wordle_dict_count * sizeof(wordle_word_entry_t);
+}
+
+#endif // WORDLE_WORD_LEN
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WORDLE_DICT_H
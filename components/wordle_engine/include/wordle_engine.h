@@ -0,0 +1,183 @@
+#ifndef WORDLE_ENGINE_H
+#define WORDLE_ENGINE_H
+
+#include <stdbool.h>
+#include <time.h>
+#include "wordle_feedback.h"
+#include "wordle_cands.h"
+#include "wordle_hint.h"
+#include "wordle_deck.h"
+#include "wordle_variant.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Game engine: all the round/score/guess logic with no Wi-Fi, httpd or JSON in it.
+// The transport owns the sockets and hands the engine the fd of whoever spoke;
+// the engine answers through the send callback with a plain message struct.
+// Each room plays one word length, its variant, which sets the rows per round.
+
+#define WORDLE_MAX_PLAYERS  2
+#define WORDLE_TIME_LIMIT   45   // Seconds per guess, advertised in round_start
+#define WORDLE_TURN_MS      (WORDLE_TIME_LIMIT * 1000)
+
+typedef enum {
+    WORDLE_MSG_WELCOME,
+    WORDLE_MSG_LOBBY_UPDATE,
+    WORDLE_MSG_GAME_STARTING,
+    WORDLE_MSG_ROUND_START,
+    WORDLE_MSG_RESULT,
+    WORDLE_MSG_OPPONENT_SUBMITTED,
+    WORDLE_MSG_BOTH_GUESSED,
+    WORDLE_MSG_ROUND_END,
+    WORDLE_MSG_TIMEOUT,
+    WORDLE_MSG_INVALID_GUESS,
+} wordle_msg_type_t;
+
+// Outgoing message, one variant per "type" the client understands
+typedef struct {
+    wordle_msg_type_t type;
+    const wordle_variant_t *variant;  // The room's word length, for the encoders
+    union {
+        struct {
+            int player_index;
+            uint32_t token;      // Session token, hand it back to reclaim the seat
+            bool resumed;        // Seat taken back with a token, a snapshot follows
+        } welcome;
+        struct {
+            int player_count;
+        } lobby_update;
+        struct {
+            int round;
+            int time_limit;
+            int hint_player;     // -1 = no hint this round
+            int hint_position;
+            char hint_letter;
+            bool hint_green;     // true = letter and position, false = letter only
+        } round_start;
+        struct {
+            char word[WORDLE_MAX_WORD_LEN + 1];
+            wordle_word_t packed;
+            int player;
+            wordle_fb_t code;    // Base-3 feedback, expanded only by the JSON encoder
+            bool is_correct;
+        } result;
+        struct {
+            int opponent;
+            int remaining;       // Answers still consistent with the opponent's feedback
+        } opponent_submitted;
+        struct {
+            char word[WORDLE_MAX_WORD_LEN + 1];
+        } invalid_guess;
+        struct {
+            int winner;          // -1 = tie/no winner
+            char target_word[WORDLE_MAX_WORD_LEN + 1];
+            int player1_score;
+            int player2_score;
+        } round_end;
+    };
+} wordle_msg_t;
+
+typedef struct game_state game_state_t;
+
+// Called by the engine for every message it wants delivered to a socket
+typedef void (*wordle_send_fn)(void *ctx, int fd, const wordle_msg_t *msg);
+
+// Called by the engine to (re)arm the room's turn deadline, delay_ms 0 cancels
+// it. Re-arming replaces the previous deadline. When it expires the transport
+// calls wordle_handle_deadline() from the same context as the other handlers.
+typedef void (*wordle_deadline_fn)(void *ctx, game_state_t *game, uint32_t delay_ms);
+
+// Called once per room-wide message (not once per recipient) and with every
+// player's result, for transports that show the room to spectators
+typedef void (*wordle_watch_fn)(void *ctx, game_state_t *game, const wordle_msg_t *msg);
+
+typedef struct {
+    int fd;
+    bool connected;
+    bool away;               // Socket dropped, seat held for a reconnect
+    uint32_t token;          // Session token from welcome, 0 = none
+    char name[32];
+    int guesses_used;
+    bool has_won;
+    int score;
+    bool waiting_for_opponent;  //Has the opponent submitted a guess
+    wordle_cands_t cands;       // Answers consistent with this round's feedback
+    int remaining;              // Count of cands
+    wordle_word_t rows[WORDLE_MAX_ROWS];  // This round's board, for snapshots
+    wordle_fb_t codes[WORDLE_MAX_ROWS];
+    int row_count;              // Rows filled, guesses_used minus timeouts
+} player_t;
+
+struct game_state {
+    player_t players[WORDLE_MAX_PLAYERS];
+    int player_count;
+    bool game_active;
+    bool first_round_pending;  // Both joined, round 1 not started yet
+    char target_word[WORDLE_MAX_WORD_LEN + 1];
+    wordle_word_t target_packed;
+    int target_index;        // Index into the variant's answers
+    int round_number;        // Current round
+    time_t round_start_time; // When the round started (for 45s timer)
+    bool round_over;         // Has this round ended?
+    int hint_player;         // Who got this round's hint, -1 = nobody
+    wordle_hint_t hint;
+
+    wordle_send_fn send;     // Transport hook, may be NULL (benchmarks)
+    void *send_ctx;
+    wordle_deadline_fn deadline;  // Turn timer hook, NULL = turns never time out
+    void *deadline_ctx;
+    wordle_watch_fn watch;   // Spectator hook, NULL = nobody watching
+    void *watch_ctx;
+    const wordle_variant_t *variant;  // Word length and guesses this room plays
+    wordle_deck_t *deck;     // Where targets come from, NULL = uniform random
+};
+
+// Reset the game and attach the transport. The room plays the default length
+// until told otherwise.
+void wordle_game_init(game_state_t *game, wordle_send_fn send, void *send_ctx);
+void wordle_game_set_deadline(game_state_t *game, wordle_deadline_fn deadline, void *ctx);
+void wordle_game_set_watch(game_state_t *game, wordle_watch_fn watch, void *ctx);
+// Play variant's words, dealt from deck (usually one shared by every room of
+// that length, NULL = uniform random). Only between games.
+void wordle_game_set_variant(game_state_t *game, const wordle_variant_t *variant, wordle_deck_t *deck);
+
+// Clear all game state for a new pair of players, keeping the transport hooks,
+// the variant and the deck
+void wordle_game_reset(game_state_t *game);
+
+// Connection management. add returns the player index or -1 when the game is full.
+// A player who is away keeps the seat and times out each turn, but is neither
+// sent anything nor found by fd.
+int wordle_add_player(game_state_t *game, int fd);
+void wordle_remove_player(game_state_t *game, int fd);
+void wordle_remove_slot(game_state_t *game, int player_index);
+int wordle_find_player(const game_state_t *game, int fd);
+void wordle_send_welcome(game_state_t *game, int player_index);
+
+void wordle_start_new_round(game_state_t *game);
+void wordle_end_round(game_state_t *game);
+
+// Inbound message handlers, player_index comes from wordle_find_player().
+// handle_join returns true once both players are named and the game should start;
+// the caller decides when to run the first round.
+bool wordle_handle_join(game_state_t *game, int player_index, const char *name);
+// Run round 1 of the game handle_join started. False, doing nothing, when a
+// player left meanwhile or the round already started.
+bool wordle_start_first_round(game_state_t *game);
+void wordle_handle_guess(game_state_t *game, int player_index, const char *guess);
+// The same for a word of word_len letters already checked and packed by the
+// frame parser. A word of another length than the room's is turned back.
+void wordle_handle_packed_guess(game_state_t *game, int player_index, wordle_word_t packed, int word_len);
+void wordle_handle_next_round(game_state_t *game);
+
+// The turn deadline armed through the deadline hook has passed: everyone who
+// has not guessed loses the guess and gets a timeout, then the turn completes.
+void wordle_handle_deadline(game_state_t *game);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WORDLE_ENGINE_H
@@ -0,0 +1,43 @@
+#ifndef WORDLE_FB_MATRIX_H
+#define WORDLE_FB_MATRIX_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "wordle_feedback.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifdef WORDLE_WORD_LEN
+#include "wordle_words.h"
+
+#define wordle_fb_matrix        WORDLE_V(wordle_fb_matrix)
+#define wordle_fb_matrix_data   WORDLE_V(wordle_fb_matrix_data)
+#define wordle_fb_matrix_bytes  WORDLE_V(wordle_fb_matrix_bytes)
+
+// Precomputed feedback for every (guess, answer) pair of wordle_answers,
+// row-major by guess index. NULL when the build left it out (too big or disabled).
+extern const wordle_fb_entry_t *const wordle_fb_matrix;
+
+// Flash used by the matrix, 0 when it is not embedded
+size_t wordle_fb_matrix_bytes(void);
+
+// Feedback of guessing wordle_answers[guess_index] when the answer is
+// wordle_answers[answer_index]. A single flash read when the matrix is
+// embedded, the packed kernel otherwise.
+static inline wordle_fb_t wordle_fb_lookup(size_t guess_index, size_t answer_index)
+{
+    if (wordle_fb_matrix != NULL) {
+        return wordle_fb_matrix[guess_index * WORDLE_ANSWER_COUNT + answer_index];
+    }
+    return wordle_feedback(wordle_answers[guess_index], wordle_answers[answer_index]);
+}
+
+#endif // WORDLE_WORD_LEN
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WORDLE_FB_MATRIX_H
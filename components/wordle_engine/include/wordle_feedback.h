@@ -0,0 +1,149 @@
+#ifndef WORDLE_FEEDBACK_H
+#define WORDLE_FEEDBACK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "wordle_variants.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Every length in the build's set (wordle_variants.h, generated) is compiled
+// side by side and each room plays one of them (wordle_variant.h). The types
+// here fit the longest. Code for a single length defines WORDLE_WORD_LEN
+// before including this: it gets that length's constants, and the names of
+// its kernels and tables map onto symbols suffixed with the length, so every
+// loop over the letters keeps a constant trip count.
+
+#if WORDLE_MIN_WORD_LEN < 4 || WORDLE_MAX_WORD_LEN > 7
+#error "word lengths must be 4 to 7"
+#endif
+
+// Packed word: letter i ('A'..'Z' -> 0..25) lives in bits [5i, 5i+5)
+#if WORDLE_MAX_WORD_LEN <= 6
+typedef uint32_t wordle_word_t;
+#else
+typedef uint64_t wordle_word_t;
+#endif
+
+// Feedback code: sum of result[i] * 3^i, result 0 = absent, 1 = present, 2 = correct
+#if WORDLE_MAX_WORD_LEN <= 5
+typedef uint8_t wordle_fb_t;
+#else
+typedef uint16_t wordle_fb_t;
+#endif
+
+// name_<WORDLE_WORD_LEN>, the symbol behind a per-length name
+#define WORDLE_CAT_(a, b)           a##_##b
+#define WORDLE_CAT(a, b)            WORDLE_CAT_(a, b)
+#define WORDLE_V(name)              WORDLE_CAT(name, WORDLE_WORD_LEN)
+
+static inline unsigned wordle_letter(wordle_word_t word, int i)
+{
+    return (word >> (5 * i)) & 31u;
+}
+
+#ifdef WORDLE_WORD_LEN
+
+#if !WORDLE_V(WORDLE_HAVE)
+#error "WORDLE_WORD_LEN is not one of the lengths this build makes"
+#endif
+
+// Fully unroll the loop that follows over the letters of a word, even at -Os
+#define WORDLE_PRAGMA(x)            _Pragma(#x)
+#define WORDLE_UNROLL_BY(n)         WORDLE_PRAGMA(GCC unroll n)
+#define WORDLE_UNROLL_LETTERS       WORDLE_UNROLL_BY(WORDLE_WORD_LEN)
+
+#if WORDLE_WORD_LEN == 4
+#define WORDLE_FB_CODES      81
+#elif WORDLE_WORD_LEN == 5
+#define WORDLE_FB_CODES      243
+#elif WORDLE_WORD_LEN == 6
+#define WORDLE_FB_CODES      729
+#else
+#define WORDLE_FB_CODES      2187
+#endif
+#define WORDLE_FB_ALL_GREEN  (WORDLE_FB_CODES - 1)
+
+// The narrowest word and code types for this length, for its flash tables
+#if WORDLE_WORD_LEN <= 6
+typedef uint32_t wordle_word_entry_t;
+#else
+typedef uint64_t wordle_word_entry_t;
+#endif
+#if WORDLE_FB_CODES <= 256
+typedef uint8_t wordle_fb_entry_t;
+#else
+typedef uint16_t wordle_fb_entry_t;
+#endif
+
+// Rows per round at this length
+#define WORDLE_MAX_GUESSES   WORDLE_V(WORDLE_GUESSES)
+
+// Bit 0 of every 5-bit lane
+#define WORDLE_LANE_LSB      ((((wordle_word_t)1 << (5 * WORDLE_WORD_LEN)) - 1) / 31)
+
+#define wordle_pack          WORDLE_V(wordle_pack)
+#define wordle_unpack        WORDLE_V(wordle_unpack)
+#define wordle_fb_expand     WORDLE_V(wordle_fb_expand)
+
+// Pack a NUL-terminated guess. Only exactly WORDLE_WORD_LEN letters A-Z are
+// accepted.
+bool wordle_pack(const char *word, wordle_word_t *out);
+
+// Unpack into WORDLE_WORD_LEN characters plus NUL
+void wordle_unpack(wordle_word_t word, char *out);
+
+// Edge helpers: expand a code into the per-letter int[WORDLE_WORD_LEN] the
+// JSON protocol uses
+void wordle_fb_expand(wordle_fb_t code, int *result);
+
+// Score a guess against an answer. Same duplicate-letter rules as the old
+// nested-loop check_guess: greens first, then each remaining guess letter, left
+// to right, takes one unmatched copy of that letter from the answer.
+static inline wordle_fb_t wordle_feedback(wordle_word_t guess, wordle_word_t answer)
+{
+    // A lane of guess ^ answer is zero exactly where the letters match. Fold
+    // each lane onto its low bit to get one "differs" bit per position.
+    wordle_word_t diff = guess ^ answer;
+    wordle_word_t differs = (diff | (diff >> 1) | (diff >> 2) | (diff >> 3) | (diff >> 4)) & WORDLE_LANE_LSB;
+
+    if (differs == 0) {
+        return WORDLE_FB_ALL_GREEN;
+    }
+
+    // Unmatched answer letters. Only the slots this pair can read are zeroed,
+    // which is cheaper than clearing all 26.
+    uint8_t counts[26];
+    WORDLE_UNROLL_LETTERS
+    for (int i = 0; i < WORDLE_WORD_LEN; i++) {
+        counts[wordle_letter(answer, i)] = 0;
+        counts[wordle_letter(guess, i)] = 0;
+    }
+    WORDLE_UNROLL_LETTERS
+    for (int i = 0; i < WORDLE_WORD_LEN; i++) {
+        counts[wordle_letter(answer, i)] += (differs >> (5 * i)) & 1u;
+    }
+
+    // Branch-free scoring pass: outcomes are data dependent and mispredict badly
+    static const uint16_t pow3[7] = {1, 3, 9, 27, 81, 243, 729};
+    unsigned code = 0;
+    WORDLE_UNROLL_LETTERS
+    for (int i = 0; i < WORDLE_WORD_LEN; i++) {
+        unsigned d = (differs >> (5 * i)) & 1u;
+        unsigned letter = wordle_letter(guess, i);
+        unsigned present = d & (counts[letter] != 0);
+        counts[letter] -= present;
+        code += pow3[i] * (present + 2 * (d ^ 1u));
+    }
+    return (wordle_fb_t)code;
+}
+
+#endif // WORDLE_WORD_LEN
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WORDLE_FEEDBACK_H
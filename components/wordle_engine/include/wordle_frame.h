@@ -0,0 +1,56 @@
+#ifndef WORDLE_FRAME_H
+#define WORDLE_FRAME_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// An encoded frame shared by several connections. Room events are serialized
+// once per format into a frame, and every spectator's queue holds a reference
+// to it instead of a copy; the last reference to go frees it.
+typedef struct {
+    uint32_t refs;
+    uint16_t len;
+    bool binary;             // WebSocket opcode: binary or text
+    uint8_t data[];
+} wordle_frame_t;
+
+// A frame of len bytes holding one reference, data left for the caller to
+// fill. Allocated from wordle_pool, NULL when that fails.
+wordle_frame_t *wordle_frame_alloc(size_t len, bool binary);
+
+// Take another reference, returns frame for chaining
+wordle_frame_t *wordle_frame_ref(wordle_frame_t *frame);
+
+// Drop a reference, freeing the frame with the last one. NULL is ignored.
+void wordle_frame_unref(wordle_frame_t *frame);
+
+// Per-connection queue of frame references, the fan-out side of wordle_outq
+#define WORDLE_FRAMEQ_LEN 16   // Power of two
+
+typedef struct {
+    uint16_t head;           // Free-running, next slot to pop
+    uint16_t tail;           // Free-running, next slot to push
+    uint32_t dropped;        // Frames refused because the queue was full
+    wordle_frame_t *frames[WORDLE_FRAMEQ_LEN];
+} wordle_frameq_t;
+
+// Append a reference to frame. False when the queue is full: nothing is
+// taken, the drop is counted and the viewer has stopped reading.
+bool wordle_frameq_push(wordle_frameq_t *q, wordle_frame_t *frame);
+
+// The oldest frame, whose reference passes to the caller. NULL when empty.
+wordle_frame_t *wordle_frameq_pop(wordle_frameq_t *q);
+
+// Drop every queued reference and empty the queue
+void wordle_frameq_clear(wordle_frameq_t *q);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WORDLE_FRAME_H
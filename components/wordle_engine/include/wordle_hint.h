@@ -0,0 +1,42 @@
+#ifndef WORDLE_HINT_H
+#define WORDLE_HINT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "wordle_feedback.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Catch-up hints sized to the score gap. Revealing a letter leaves the
+// answers containing it, revealing it with its position leaves the answers
+// with it there; both counts are build-time tables, so picking is one
+// lookup per letter. The hint chosen is the one of the target's letters that leaves
+// closest to 1 / (gap + 1) of the list, so a bigger gap buys a stronger hint
+// and an 'E' or a 'Z' no longer decides it by luck.
+#define WORDLE_HINT_MIN_GAP    2   // Letter only
+#define WORDLE_HINT_GREEN_GAP  4   // Letter and position
+
+typedef struct {
+    int position;            // Where the letter is, shown only for green hints
+    char letter;
+    bool green;
+    uint16_t remaining;      // Answers consistent with the hint alone
+} wordle_hint_t;
+
+#ifdef WORDLE_WORD_LEN
+
+#define wordle_hint_pick  WORDLE_V(wordle_hint_pick)
+
+// Pick the hint about target for a trailing player score_gap points behind
+// (at least WORDLE_HINT_MIN_GAP)
+void wordle_hint_pick(wordle_word_t target, int score_gap, wordle_hint_t *hint);
+
+#endif // WORDLE_WORD_LEN
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WORDLE_HINT_H
@@ -0,0 +1,43 @@
+#ifndef WORDLE_INBOUND_H
+#define WORDLE_INBOUND_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "wordle_feedback.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Parser for client -> server frames: one flat JSON object such as
+// {"type":"guess","word":"CRANE"} or {"type":"join","name":"Ann","bot":true}.
+// It scans the receive buffer once, decodes strings in place and allocates
+// nothing. Unknown keys and values of any shape are skipped, so clients may
+// send fields the server does not know yet.
+
+typedef enum {
+    WORDLE_IN_MALFORMED,     // Not a JSON object, or no "type" string
+    WORDLE_IN_NONE,          // Well-formed, but an unknown type or a field is missing
+    WORDLE_IN_JOIN,
+    WORDLE_IN_GUESS,
+    WORDLE_IN_NEXT_ROUND,
+} wordle_in_type_t;
+
+typedef struct {
+    const char *name;        // join: NUL-terminated, inside the buffer
+    bool bot;                // join: "bot":true, play against the solver
+    const char *word;        // guess: as sent, NUL-terminated, inside the buffer
+    bool word_ok;            // guess: WORDLE_MIN_WORD_LEN to WORDLE_MAX_WORD_LEN letters A-Z, packed below
+    wordle_word_t packed;
+    int word_len;            // Letters in packed, for the room to check against its own
+} wordle_in_msg_t;
+
+// Parse len bytes of buf, overwriting it. Fields not used by the returned type
+// are left unset.
+wordle_in_type_t wordle_parse_inbound(char *buf, size_t len, wordle_in_msg_t *msg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WORDLE_INBOUND_H
@@ -0,0 +1,38 @@
+#ifndef WORDLE_JSON_H
+#define WORDLE_JSON_H
+
+#include "cJSON.h"
+#include "wordle_engine.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Route every cJSON allocation (parse trees, built messages, print buffers)
+// through the block pools in wordle_pool.h. Call once before any cJSON use;
+// strings from wordle_msg_to_json() must then be released with cJSON_free().
+void wordle_json_use_pool(void);
+
+// Build the cJSON tree for an engine message, the caller deletes it.
+// NULL on allocation failure.
+cJSON *wordle_msg_to_cjson(const wordle_msg_t *msg);
+
+// Serialize an engine message into the JSON the browser client expects,
+// without pretty-printing. Returns a string the caller releases with cJSON_free().
+// NULL on allocation failure.
+char *wordle_msg_to_json(const wordle_msg_t *msg);
+
+// Several messages in one frame: a JSON array of message objects, or the bare
+// object when count is 1. Same ownership as wordle_msg_to_json().
+char *wordle_msgs_to_json(const wordle_msg_t *msgs, int count);
+
+// JSON form of wordle_snapshot_to_binary(): {"type":"snapshot", round, scores,
+// active, round_over, the hint fields as in round_start, and players[] of
+// {guesses_used, rows: [{word, result}]}}. Same ownership as wordle_msg_to_json().
+char *wordle_snapshot_to_json(const game_state_t *game, int viewer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WORDLE_JSON_H
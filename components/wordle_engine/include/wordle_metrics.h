@@ -0,0 +1,48 @@
+#ifndef WORDLE_METRICS_H
+#define WORDLE_METRICS_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Latency histogram with power-of-two buckets: bucket i counts samples of at
+// most WORDLE_HIST_BASE_US << i microseconds, the last bucket everything
+// larger. Recording is a count-leading-zeros and three adds, cheap enough to
+// stay on in production. One writer per histogram; readers may see a sample
+// half-applied, which a scraper polling rates does not care about.
+#define WORDLE_HIST_BUCKETS  16
+#define WORDLE_HIST_BASE_US  32   // First bound, the last finite one is ~524 ms
+
+typedef struct {
+    uint32_t buckets[WORDLE_HIST_BUCKETS];
+    uint32_t count;
+    uint64_t sum_us;
+} wordle_hist_t;
+
+static inline void wordle_hist_add(wordle_hist_t *h, uint32_t us)
+{
+    unsigned i = 0;
+    if (us > WORDLE_HIST_BASE_US) {
+        i = 32 - __builtin_clz((us - 1) / WORDLE_HIST_BASE_US);
+        if (i >= WORDLE_HIST_BUCKETS) {
+            i = WORDLE_HIST_BUCKETS - 1;
+        }
+    }
+    h->buckets[i]++;
+    h->count++;
+    h->sum_us += us;
+}
+
+// Inclusive upper bound of bucket i in microseconds, 0 for the open last one
+static inline uint32_t wordle_hist_bound_us(unsigned i)
+{
+    return i + 1 < WORDLE_HIST_BUCKETS ? (uint32_t)WORDLE_HIST_BASE_US << i : 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WORDLE_METRICS_H
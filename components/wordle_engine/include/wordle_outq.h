@@ -0,0 +1,41 @@
+#ifndef WORDLE_OUTQ_H
+#define WORDLE_OUTQ_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "wordle_engine.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Per-connection outbound queue. Game logic pushes messages from whatever task
+// runs the event, a sender task pops everything queued since its last pass and
+// writes it as one frame, so the messages of one event share a frame and a
+// slow socket only ever stalls the sender, never the game.
+#define WORDLE_OUTQ_LEN 16   // Power of two, a guess produces at most 4 per seat
+
+typedef struct {
+    int fd;                  // Destination, -1 while the seat is empty
+    uint16_t head;           // Free-running, next slot to pop
+    uint16_t tail;           // Free-running, next slot to push
+    uint32_t dropped;        // Messages refused because the queue was full
+    wordle_msg_t msgs[WORDLE_OUTQ_LEN];
+} wordle_outq_t;
+
+// Empty the queue and point it at fd (-1 to park it)
+void wordle_outq_reset(wordle_outq_t *q, int fd);
+
+// Append a message for q->fd. False when the queue is full: the message is
+// dropped and counted, and the caller should treat the client as stalled.
+bool wordle_outq_push(wordle_outq_t *q, const wordle_msg_t *msg);
+
+// Move up to max queued messages into out, oldest first, and report their fd.
+// Returns the count, 0 when empty.
+int wordle_outq_pop(wordle_outq_t *q, wordle_msg_t *out, int max, int *fd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WORDLE_OUTQ_H
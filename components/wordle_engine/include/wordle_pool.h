@@ -0,0 +1,49 @@
+#ifndef WORDLE_POOL_H
+#define WORDLE_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Fixed-size block pools for the short-lived allocations of message handling:
+// cJSON nodes, key/value strings and print buffers. Requests go to the smallest
+// class with a free block and fall back to the heap (counted) when the request
+// is too large or the class is exhausted, so an undersized pool costs speed,
+// never correctness. wordle_pool_free() accepts pooled and fallback pointers.
+//
+// Blocks per class, sized from the high-water marks of a multi-room game.
+// Only one message tree is alive at a time per sending task.
+#define WORDLE_POOL_CLASSES 5
+#define WORDLE_POOL_BLOCKS_16   48
+#define WORDLE_POOL_BLOCKS_32   32
+#define WORDLE_POOL_BLOCKS_64   32
+#define WORDLE_POOL_BLOCKS_128  8
+#define WORDLE_POOL_BLOCKS_256  4
+
+typedef struct {
+    uint16_t block_size;
+    uint16_t blocks;
+    uint16_t in_use;
+    uint16_t high_water;     // Most blocks ever in use at once
+    uint32_t allocs;
+} wordle_pool_class_stats_t;
+
+typedef struct {
+    wordle_pool_class_stats_t classes[WORDLE_POOL_CLASSES];
+    uint32_t fallbacks;      // Requests served by the heap
+    uint32_t fallback_max;   // Largest request that fell back, in bytes
+} wordle_pool_stats_t;
+
+void *wordle_pool_malloc(size_t size);
+void wordle_pool_free(void *ptr);
+
+void wordle_pool_get_stats(wordle_pool_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WORDLE_POOL_H
@@ -0,0 +1,76 @@
+#ifndef WORDLE_PROTO_H
+#define WORDLE_PROTO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "wordle_engine.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Compact binary encoding of server -> client messages, sent as
+// HTTPD_WS_TYPE_BINARY frames to clients that connect with /ws?proto=bin.
+// Byte 0 is the message type, multi-byte fields are little-endian. Words are
+// packed words (letter i in bits 5i..5i+4) in as many bytes as the room's
+// word length needs, feedback codes one byte up to five letters and two
+// above; WELCOME and SNAPSHOT carry the length so the client can size the
+// rest. script.js mirrors this.
+//
+//   WELCOME             01 player_index token:u32 resumed word_len max_guesses
+//   LOBBY_UPDATE        02 player_count
+//   GAME_STARTING       03
+//   ROUND_START         04 round:u16 time_limit hint_player(FF = none) hint_position hint_letter hint_green
+//   RESULT              05 player code word              is_correct = (code == all green)
+//   OPPONENT_SUBMITTED  06 opponent remaining:u16
+//   BOTH_GUESSED        07
+//   ROUND_END           08 winner(FF = tie) score1:u16 score2:u16 target
+//   TIMEOUT             09
+//   INVALID_GUESS       0A word_len ASCII bytes, NUL padded
+//   SNAPSHOT            0B len round:u16 score1:u16 score2:u16 flags(1 = active, 2 = round over)
+//                          hint_player hint_position hint_letter hint_green word_len max_guesses
+//                          then per player: guesses_used rows, rows x (code word)
+//
+// SNAPSHOT is the only variable-length message: len counts the bytes after it.
+typedef enum {
+    WORDLE_BIN_WELCOME = 0x01,
+    WORDLE_BIN_LOBBY_UPDATE,
+    WORDLE_BIN_GAME_STARTING,
+    WORDLE_BIN_ROUND_START,
+    WORDLE_BIN_RESULT,
+    WORDLE_BIN_OPPONENT_SUBMITTED,
+    WORDLE_BIN_BOTH_GUESSED,
+    WORDLE_BIN_ROUND_END,
+    WORDLE_BIN_TIMEOUT,
+    WORDLE_BIN_INVALID_GUESS,
+    WORDLE_BIN_SNAPSHOT,
+} wordle_bin_type_t;
+
+// Bytes per packed word and per feedback code on the wire, for a word length
+#define WORDLE_BIN_WORD_BYTES(len) ((5 * (len) + 7) / 8)
+#define WORDLE_BIN_CODE_BYTES(len) ((len) <= 5 ? 1 : 2)
+
+// Largest encoded message (ROUND_END), and largest snapshot, at any length
+#define WORDLE_BIN_MAX_LEN (6 + WORDLE_BIN_WORD_BYTES(WORDLE_MAX_WORD_LEN))
+#define WORDLE_BIN_SNAPSHOT_MAX (15 + WORDLE_MAX_PLAYERS * \
+                                 (2 + WORDLE_MAX_ROWS * (WORDLE_BIN_CODE_BYTES(WORDLE_MAX_WORD_LEN) + \
+                                                         WORDLE_BIN_WORD_BYTES(WORDLE_MAX_WORD_LEN))))
+
+// Encode msg into out (at least WORDLE_BIN_MAX_LEN bytes), returns the length
+size_t wordle_msg_to_binary(const wordle_msg_t *msg, uint8_t *out);
+
+// Encode count messages back to back into one frame payload (out holds at
+// least count * WORDLE_BIN_MAX_LEN bytes). The client splits them by type.
+size_t wordle_msgs_to_binary(const wordle_msg_t *msgs, int count, uint8_t *out);
+
+// The room as it stands, for someone arriving mid-game: scores, round, hint
+// and both boards. viewer is the receiving player's slot, whose opponent's
+// rows are left out as they would be live, or -1 for a spectator who sees
+// both. out holds at least WORDLE_BIN_SNAPSHOT_MAX bytes.
+size_t wordle_snapshot_to_binary(const game_state_t *game, int viewer, uint8_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WORDLE_PROTO_H
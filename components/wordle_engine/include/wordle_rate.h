@@ -0,0 +1,67 @@
+#ifndef WORDLE_RATE_H
+#define WORDLE_RATE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Token bucket per connection, kept as a theoretical arrival time (GCRA):
+// a frame is allowed while tat is no further than burst intervals ahead of
+// now, and each allowed frame pushes tat one interval on. A second bucket of
+// the same shape counts dropped frames, so a client that keeps pushing
+// against the limit is told to go away instead of being dropped forever.
+// One writer per connection, no locks.
+#ifndef CONFIG_WORDLE_RATE_PER_S
+#define CONFIG_WORDLE_RATE_PER_S  4
+#endif
+#ifndef CONFIG_WORDLE_RATE_BURST
+#define CONFIG_WORDLE_RATE_BURST  8
+#endif
+#ifndef CONFIG_WORDLE_RATE_STRIKES
+#define CONFIG_WORDLE_RATE_STRIKES 16
+#endif
+
+#define WORDLE_RATE_INTERVAL_US (1000000 / CONFIG_WORDLE_RATE_PER_S)
+
+typedef struct {
+    int64_t tat;             // When the frame bucket is empty again
+    int64_t strike_tat;      // The same for dropped frames
+} wordle_rate_t;
+
+static inline void wordle_rate_reset(wordle_rate_t *r, int64_t now_us)
+{
+    r->tat = now_us;
+    r->strike_tat = now_us;
+}
+
+static inline bool wordle_rate_take(int64_t *tat, int64_t now_us, int burst)
+{
+    int64_t t = *tat > now_us ? *tat : now_us;
+    if (t - now_us >= (int64_t)burst * WORDLE_RATE_INTERVAL_US) {
+        return false;
+    }
+    *tat = t + WORDLE_RATE_INTERVAL_US;
+    return true;
+}
+
+// True when a frame arriving now is within the limit
+static inline bool wordle_rate_allow(wordle_rate_t *r, int64_t now_us)
+{
+    return wordle_rate_take(&r->tat, now_us, CONFIG_WORDLE_RATE_BURST);
+}
+
+// Record a dropped frame. True once drops have outrun the strike budget
+// (which refills at the frame rate) and the connection should be closed.
+static inline bool wordle_rate_strike(wordle_rate_t *r, int64_t now_us)
+{
+    return !wordle_rate_take(&r->strike_tat, now_us, CONFIG_WORDLE_RATE_STRIKES);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WORDLE_RATE_H
@@ -0,0 +1,107 @@
+#ifndef WORDLE_SERVER_H
+#define WORDLE_SERVER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "wordle_engine.h"
+
+#ifdef ESP_PLATFORM
+#include "sdkconfig.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Room table: many independent 2-player games behind one transport. Host
+// builds (benchmarks) get generous defaults, the device takes them from Kconfig.
+#ifndef CONFIG_WORDLE_MAX_ROOMS
+#define CONFIG_WORDLE_MAX_ROOMS 1024
+#endif
+#ifndef CONFIG_WORDLE_MAX_FDS
+#define CONFIG_WORDLE_MAX_FDS 4096
+#endif
+
+#ifndef CONFIG_WORDLE_RECONNECT_GRACE_S
+#define CONFIG_WORDLE_RECONNECT_GRACE_S 30
+#endif
+
+#define WORDLE_MAX_ROOMS  CONFIG_WORDLE_MAX_ROOMS
+#define WORDLE_MAX_FDS    CONFIG_WORDLE_MAX_FDS
+#define WORDLE_FD_UNUSED  0xFFFF
+#define WORDLE_RECONNECT_GRACE_MS (CONFIG_WORDLE_RECONNECT_GRACE_S * 1000)
+
+// The in-process bot takes a seat under a negative pseudo-fd, one per room, so
+// the engine addresses it like any player and the transport can route it
+#define WORDLE_BOT_FD(room)      (-2 - (room))
+#define WORDLE_IS_BOT_FD(fd)     ((fd) <= -2)
+#define WORDLE_BOT_FD_ROOM(fd)   (-2 - (fd))
+
+typedef struct {
+    game_state_t rooms[WORDLE_MAX_ROOMS];
+    // (fd - fd_base) -> room << 1 | slot, WORDLE_FD_UNUSED when not playing
+    uint16_t fd_index[WORDLE_MAX_FDS];
+    int fd_base;             // Lowest fd the transport hands out
+    int rooms_in_use;
+    // One per word length, shared by the rooms playing it so they deal
+    // different words. Indexed like wordle_variants[].
+    wordle_deck_t decks[WORDLE_VARIANT_COUNT];
+} wordle_server_t;
+
+_Static_assert(WORDLE_MAX_PLAYERS == 2, "fd_index packs the slot into one bit");
+_Static_assert(WORDLE_MAX_ROOMS < 0x7FFF, "fd_index packs the room into 15 bits");
+
+// Reset every room, attach the transport to all of them and shuffle the word
+// decks they share
+void wordle_server_init(wordle_server_t *server, int fd_base, wordle_send_fn send, void *send_ctx);
+
+// Attach the turn timer to every room
+void wordle_server_set_deadline(wordle_server_t *server, wordle_deadline_fn deadline, void *ctx);
+
+// Seat a new connection that wants to play variant's word length (NULL for the
+// default): first a room of that length with a player waiting for an
+// opponent, otherwise an empty one, which takes the length. Issues the
+// session token. Returns the room and sets *slot, NULL when full.
+game_state_t *wordle_server_connect(wordle_server_t *server, int fd, const wordle_variant_t *variant, int *slot);
+
+// Give a held seat back to the connection presenting its token. The token is
+// replaced (send it with a resumed welcome). NULL when no seat is held for it.
+game_state_t *wordle_server_resume(wordle_server_t *server, int fd, uint32_t token, int *slot);
+
+// Seat the bot beside the player in slot, named so the game starts on that
+// player's join. A connection in the other seat that has not joined yet is
+// moved to another room of its length first: *moved is then its fd (otherwise -1), and the
+// transport finds its new seat with wordle_server_lookup() and welcomes it
+// there. False when the other seat's player has joined, or every other room
+// is busy.
+bool wordle_server_add_bot(wordle_server_t *server, game_state_t *room, int slot, int *moved);
+
+// Free the connection's seat, emptied rooms are reset for the next match. A
+// bot left alone in a room leaves with the last human.
+//
+// With hold set and a match on, the seat is kept instead: the player is away,
+// times out each turn and can come back through wordle_server_resume(). Returns
+// true when held; the transport then calls wordle_server_release() with the
+// seat's current token once WORDLE_RECONNECT_GRACE_MS has passed.
+bool wordle_server_disconnect(wordle_server_t *server, int fd, bool hold);
+
+// End of the grace period: free the seat if it is still held under token
+void wordle_server_release(wordle_server_t *server, game_state_t *room, int slot, uint32_t token);
+
+// Constant-time fd -> (room, slot) for message dispatch. NULL if fd is not seated.
+static inline game_state_t *wordle_server_lookup(wordle_server_t *server, int fd, int *slot)
+{
+    unsigned index = (unsigned)(fd - server->fd_base);
+    if (index >= WORDLE_MAX_FDS || server->fd_index[index] == WORDLE_FD_UNUSED) {
+        return NULL;
+    }
+    uint16_t seat = server->fd_index[index];
+    *slot = seat & 1;
+    return &server->rooms[seat >> 1];
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WORDLE_SERVER_H
@@ -0,0 +1,46 @@
+#ifndef WORDLE_SOLVER_H
+#define WORDLE_SOLVER_H
+
+#include <stdint.h>
+#include "wordle_feedback.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Entropy solver over the answer list. Guesses and candidates are indices into
+// wordle_answers, so scoring is a feedback matrix read when it is embedded.
+// Sized for the longest answer list, so one solver serves any length.
+typedef struct {
+    uint16_t candidates[WORDLE_MAX_ANSWERS];  // Answers consistent with every result so far
+    uint16_t count;
+} wordle_solver_t;
+
+_Static_assert(WORDLE_MAX_ANSWERS <= UINT16_MAX, "candidates are 16-bit answer indices");
+
+#ifdef WORDLE_WORD_LEN
+#include "wordle_words.h"
+
+#define wordle_solver_reset       WORDLE_V(wordle_solver_reset)
+#define wordle_solver_filter      WORDLE_V(wordle_solver_filter)
+#define wordle_solver_best_guess  WORDLE_V(wordle_solver_best_guess)
+
+// Every answer is possible again
+void wordle_solver_reset(wordle_solver_t *solver);
+
+// Keep the candidates that would have given code for this guess
+void wordle_solver_filter(wordle_solver_t *solver, uint16_t guess_index, wordle_fb_t code);
+
+// Guess with the most expected information (Shannon entropy of the feedback
+// distribution) over the remaining candidates; ties go to a guess that could
+// itself be the answer. Costs WORDLE_ANSWER_COUNT * count lookups, except for
+// the opening guess, which is computed once and remembered. Not reentrant.
+uint16_t wordle_solver_best_guess(const wordle_solver_t *solver);
+
+#endif // WORDLE_WORD_LEN
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WORDLE_SOLVER_H
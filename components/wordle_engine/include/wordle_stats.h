@@ -0,0 +1,69 @@
+#ifndef WORDLE_STATS_H
+#define WORDLE_STATS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "wordle_engine.h"
+
+#ifdef ESP_PLATFORM
+#include "sdkconfig.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Leaderboard and match history, kept by player name across matches. Fixed
+// size so it lives in RAM next to the rooms and persists as a handful of
+// blobs: the transport saves the entries marked dirty (and the history) from
+// a background task, never on the game's task.
+#ifndef CONFIG_WORDLE_STATS_PLAYERS
+#define CONFIG_WORDLE_STATS_PLAYERS 32
+#endif
+#define WORDLE_STATS_PLAYERS  CONFIG_WORDLE_STATS_PLAYERS
+#define WORDLE_STATS_HISTORY  16   // Rounds kept in the history ring
+#define WORDLE_STATS_NAME_LEN 16   // Names are truncated to 15 characters
+
+_Static_assert(WORDLE_STATS_PLAYERS <= 32, "dirty set is one 32-bit mask");
+
+typedef struct {
+    char name[WORDLE_STATS_NAME_LEN];   // Empty = free slot
+    uint16_t played;         // Rounds finished
+    uint16_t wins;           // Rounds won outright
+    uint16_t solved[WORDLE_MAX_ROWS];  // Rounds solved in 1..WORDLE_MAX_ROWS guesses, any length
+    uint32_t last_round;     // stats->rounds when last seen, for eviction
+} wordle_stats_entry_t;
+
+typedef struct {
+    char names[WORDLE_MAX_PLAYERS][WORDLE_STATS_NAME_LEN];
+    int8_t winner;           // -1 = tie or nobody solved it
+    uint8_t guesses[WORDLE_MAX_PLAYERS];  // Guesses used, timeouts included
+    uint8_t solved;          // Bit i = player i solved it
+    uint8_t word_len;        // Of the room it was played in
+    wordle_word_t target;
+} wordle_stats_round_t;
+
+typedef struct {
+    wordle_stats_entry_t entries[WORDLE_STATS_PLAYERS];
+    wordle_stats_round_t history[WORDLE_STATS_HISTORY];
+    uint32_t rounds;         // Rounds recorded ever, history[rounds % HISTORY] is next
+    uint32_t dirty;          // Bit i = entries[i] changed since the last save
+    bool history_dirty;
+} wordle_stats_t;
+
+void wordle_stats_init(wordle_stats_t *stats);
+
+// Record a finished round from the room's state at round_end. Unnamed seats
+// are skipped; a new name takes a free slot or evicts the player with the
+// fewest rounds (least recently seen on a tie).
+void wordle_stats_record(wordle_stats_t *stats, const game_state_t *game, int winner);
+
+// Indices of the used entries, best first: most wins, then fewest average
+// guesses per solve, then most rounds. Returns the count written (<= max).
+int wordle_stats_rank(const wordle_stats_t *stats, uint8_t *order, int max);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WORDLE_STATS_H
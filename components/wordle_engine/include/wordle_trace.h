@@ -0,0 +1,81 @@
+#ifndef WORDLE_TRACE_H
+#define WORDLE_TRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef ESP_PLATFORM
+#include "sdkconfig.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Binary event trace for the hot path. Writers claim a slot in a fixed ring
+// with one atomic add and store 16 bytes, no formatting and no locks; the
+// ring is turned back into text only when someone reads it (GET /trace).
+// Events above WORDLE_TRACE_LEVEL compile to nothing.
+#ifndef CONFIG_WORDLE_TRACE_LEVEL
+#define CONFIG_WORDLE_TRACE_LEVEL 1
+#endif
+#ifndef CONFIG_WORDLE_TRACE_LEN
+#define CONFIG_WORDLE_TRACE_LEN 256
+#endif
+
+#define WORDLE_TRACE_LEVEL  CONFIG_WORDLE_TRACE_LEVEL
+#define WORDLE_TRACE_LEN    CONFIG_WORDLE_TRACE_LEN
+
+#define WORDLE_TRACE_GAME   1   // Rounds, guesses, timeouts
+#define WORDLE_TRACE_FRAME  2   // Every WebSocket frame in and out
+
+typedef enum {
+    WORDLE_EV_WS_OPEN,       // a = room, b = slot
+    WORDLE_EV_WS_RX,         // a = payload bytes
+    WORDLE_EV_WS_TX,         // a = messages, b = payload bytes
+    WORDLE_EV_ROUND_START,   // a = word length << 24 | round, b = target (index into the length's answers)
+    WORDLE_EV_HINT,          // a = player, b = position << 8 | letter, +0x10000 if green
+    WORDLE_EV_GUESS,         // a = word length << 28 | word bits 32+ << 24 | feedback code << 8 | player, b = packed guess
+    WORDLE_EV_GUESS_IGNORED, // a = player, b = 0 already submitted, 1 round over or won, 2 no round yet
+    WORDLE_EV_INVALID_GUESS, // a = player
+    WORDLE_EV_TURN_DONE,     // a = round, b = guesses used by player 1 << 8 | player 2
+    WORDLE_EV_TIMEOUT,       // a = player
+    WORDLE_EV_ROUND_END,     // a = round, b = winner (-1 tie)
+    WORDLE_EV_NEXT_ROUND,    // a = 1 accepted, 0 refused (round not over)
+    WORDLE_EV_COUNT
+} wordle_trace_event_t;
+
+typedef struct {
+    uint32_t time_us;        // esp_timer_get_time(), wraps after 71 minutes
+    uint16_t event;
+    int16_t fd;
+    int32_t a;
+    int32_t b;
+} wordle_trace_entry_t;
+
+_Static_assert(sizeof(wordle_trace_entry_t) == 16, "trace entries are 16 bytes");
+
+#define WORDLE_TRACE(level, event, fd, a, b) do {                  \
+        if ((level) <= WORDLE_TRACE_LEVEL) {                         \
+            wordle_trace_write((event), (fd), (a), (b));             \
+        }                                                            \
+    } while (0)
+
+void wordle_trace_write(wordle_trace_event_t event, int fd, int32_t a, int32_t b);
+
+// Total events ever written. The ring holds the last WORDLE_TRACE_LEN of them,
+// sequence numbers [max(0, head - WORDLE_TRACE_LEN), head).
+uint32_t wordle_trace_head(void);
+
+// Copy out event number seq. A writer lapping the reader mid-copy can tear an
+// entry; this is a debugging aid, not a log of record.
+void wordle_trace_read(uint32_t seq, wordle_trace_entry_t *out);
+
+// One line of text for an entry, snprintf semantics
+int wordle_trace_format(const wordle_trace_entry_t *entry, char *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WORDLE_TRACE_H
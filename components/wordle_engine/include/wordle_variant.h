@@ -0,0 +1,70 @@
+#ifndef WORDLE_VARIANT_H
+#define WORDLE_VARIANT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "wordle_feedback.h"
+#include "wordle_cands.h"
+#include "wordle_hint.h"
+#include "wordle_solver.h"
+#include "wordle_deck.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// One word length as the rest of the engine sees it. Every length in the build
+// has its tables and kernels compiled for it (wordle_variant.c.in); a room
+// picks one of these when it is created and goes through it for anything that
+// depends on the length. The functions are the per-length ones of the same
+// name, see their headers.
+typedef struct {
+    int word_len;
+    int max_guesses;            // Rows per round
+    int index;                  // Position in wordle_variants[]
+    int answer_count;
+    wordle_fb_t all_green;      // Code of a solved guess
+    const wordle_word_t *answers;
+
+    bool (*pack)(const char *word, wordle_word_t *out);
+    void (*unpack)(wordle_word_t word, char *out);
+    void (*fb_expand)(wordle_fb_t code, int *result);
+    wordle_fb_t (*feedback)(wordle_word_t guess, wordle_word_t answer);
+    bool (*dict_contains)(wordle_word_t word);
+
+    void (*cands_reset)(wordle_cands_t *cands);
+    void (*cands_apply)(wordle_cands_t *cands, wordle_word_t guess, wordle_fb_t code);
+    int (*cands_count)(const wordle_cands_t *cands);
+    void (*hint_pick)(wordle_word_t target, int score_gap, wordle_hint_t *hint);
+
+    void (*solver_reset)(wordle_solver_t *solver);
+    void (*solver_filter)(wordle_solver_t *solver, uint16_t guess_index, wordle_fb_t code);
+    uint16_t (*solver_best_guess)(const wordle_solver_t *solver);
+
+    void (*deck_init)(wordle_deck_t *deck, uint32_t seed);
+    bool (*deck_restore)(wordle_deck_t *deck, const wordle_deck_pos_t *pos);
+    uint16_t (*deck_draw)(wordle_deck_t *deck, wordle_tier_t tier);
+} wordle_variant_t;
+
+// The lengths built, shortest first
+extern const wordle_variant_t *const wordle_variants[WORDLE_VARIANT_COUNT];
+
+// Variant for word_len, NULL when this build does not have that length
+const wordle_variant_t *wordle_variant_get(int word_len);
+
+// Rooms whose players ask for no particular length play this one
+#define WORDLE_DEFAULT_VARIANT  (wordle_variants[WORDLE_DEFAULT_VARIANT_INDEX])
+
+#ifdef WORDLE_WORD_LEN
+#define wordle_variant  WORDLE_V(wordle_variant)
+
+// This length's descriptor
+extern const wordle_variant_t wordle_variant;
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // WORDLE_VARIANT_H
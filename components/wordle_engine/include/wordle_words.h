@@ -0,0 +1,20 @@
+#ifndef WORDLE_WORDS_H
+#define WORDLE_WORDS_H
+
+#include "wordle_feedback.h"
+
+// Answer tables of the length being compiled, generated by gen_words.py into
+// one header per length
+#if !defined(WORDLE_WORD_LEN)
+#error "wordle_words.h is for code built for one length, define WORDLE_WORD_LEN"
+#elif WORDLE_WORD_LEN == 4
+#include "wordle_words_4.h"
+#elif WORDLE_WORD_LEN == 5
+#include "wordle_words_5.h"
+#elif WORDLE_WORD_LEN == 6
+#include "wordle_words_6.h"
+#else
+#include "wordle_words_7.h"
+#endif
+
+#endif // WORDLE_WORDS_H
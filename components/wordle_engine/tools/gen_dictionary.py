@@ -0,0 +1,59 @@
+#!/usr/bin/env python3
+"""Build the allowed-guess dictionary as packed words in Eytzinger order.
+
+Every word is packed like wordle_pack() (letter i in bits 5i..5i+4), the set
+is deduplicated and sorted, then laid out as an implicit 1-based binary tree
+(Eytzinger layout) so wordle_dict_contains() walks it with a branch-free loop
+and good cache/flash locality. Every answer is always included.
+
+    gen_dictionary.py allowed.txt answers.txt --length 5 --c wordle_dict_5.c
+"""
+import argparse
+
+from wordlist import add_length_argument, pack, read_words
+
+
+def eytzinger(sorted_keys):
+    out = [0] * (len(sorted_keys) + 1)
+    it = iter(sorted_keys)
+
+    def fill(k):
+        if k <= len(sorted_keys):
+            fill(2 * k)
+            out[k] = next(it)
+            fill(2 * k + 1)
+
+    fill(1)
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('allowed_txt')
+    parser.add_argument('answers_txt')
+    parser.add_argument('--c', required=True, help='output C source')
+    add_length_argument(parser)
+    args = parser.parse_args()
+
+    allowed, _ = read_words(args.allowed_txt, args.length)
+    answers, _ = read_words(args.answers_txt, args.length)
+    keys = sorted({pack(w) for w in allowed + answers})
+    tree = eytzinger(keys)
+    digits = (5 * args.length + 3) // 4
+    key_bytes = 4 if args.length <= 6 else 8
+
+    with open(args.c, 'w', encoding='utf-8') as f:
+        f.write('// Generated by gen_dictionary.py, do not edit\n')
+        f.write(f'#define WORDLE_WORD_LEN {args.length}\n')
+        f.write('#include "wordle_dict.h"\n\n')
+        f.write(f'const size_t wordle_dict_count = {len(keys)};\n\n')
+        f.write('// 1-based Eytzinger layout, slot 0 is unused\n')
+        f.write(f'const wordle_word_entry_t wordle_dict_tree[{len(tree)}] = {{\n')
+        for i in range(0, len(tree), 8):
+            f.write('    ' + ', '.join(f'0x{k:0{digits}x}' for k in tree[i:i + 8]) + ',\n')
+        f.write('};\n')
+    print(f'dictionary: {len(keys)} words, {len(keys) * key_bytes} bytes')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+"""Rate every answer by how many guesses the entropy solver needs for it.
+
+Plays the same solver as wordle_solver.c (most expected information over the
+answer list, ties to a guess that could be the answer) against each answer,
+sharing the search tree between answers, and emits the guess counts plus the
+answers split into difficulty tiers of equal size, easiest first. Within a
+guess count, answers left in a bigger group after the opening guess rank
+harder.
+
+    gen_difficulty.py answers.txt --length 5 --c wordle_difficulty_5.c
+"""
+import argparse
+import math
+
+from wordlist import add_length_argument, feedback, read_words
+
+TIERS = 3  # Must match WORDLE_TIERS in wordle_deck.h
+
+
+def best_guess(matrix, n, candidates, is_candidate):
+    """Index of the guess with the smallest sum of c * log2(c) over its
+    feedback buckets, like wordle_solver_best_guess()."""
+    if len(candidates) <= 2:
+        return candidates[0]
+    best, best_cost, best_is_candidate = candidates[0], math.inf, True
+    for g in range(n):
+        row = matrix[g * n:(g + 1) * n]
+        buckets = {}
+        for a in candidates:
+            code = row[a]
+            buckets[code] = buckets.get(code, 0) + 1
+        cost = sum(c * math.log2(c) for c in buckets.values())
+        candidate = is_candidate[g]
+        if cost < best_cost - 1e-3 or (cost < best_cost + 1e-3 and candidate and not best_is_candidate):
+            best, best_cost, best_is_candidate = g, cost, candidate
+    return best
+
+
+def solve_all(matrix, n):
+    """Guesses the solver takes for each answer, and the size of each
+    answer's group after the opening guess."""
+    guesses = [0] * n
+    opener_group = [0] * n
+    # Walk the solver's decision tree: (candidates, depth) still to split
+    pending = [(list(range(n)), 1)]
+    while pending:
+        candidates, depth = pending.pop()
+        is_candidate = [False] * n
+        for a in candidates:
+            is_candidate[a] = True
+        g = best_guess(matrix, n, candidates, is_candidate)
+        groups = {}
+        for a in candidates:
+            if a == g:
+                guesses[a] = depth
+            else:
+                groups.setdefault(matrix[g * n + a], []).append(a)
+        for group in groups.values():
+            if depth == 1:
+                for a in group:
+                    opener_group[a] = len(group)
+            pending.append((group, depth + 1))
+    return guesses, opener_group
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('answers_txt')
+    parser.add_argument('--c', required=True, help='write the tables as C source')
+    add_length_argument(parser)
+    args = parser.parse_args()
+
+    words, _ = read_words(args.answers_txt, args.length)
+    n = len(words)
+    matrix = [feedback(g, a) for g in words for a in words]
+    guesses, opener_group = solve_all(matrix, n)
+
+    order = sorted(range(n), key=lambda a: (guesses[a], opener_group[a], a))
+    starts = [n * t // TIERS for t in range(TIERS + 1)]
+
+    with open(args.c, 'w', encoding='utf-8') as f:
+        f.write(f'// Generated by gen_difficulty.py from words/{args.length}/answers.txt, do not edit\n')
+        f.write(f'#define WORDLE_WORD_LEN {args.length}\n')
+        f.write('#include "wordle_deck.h"\n\n')
+        f.write(f'_Static_assert(WORDLE_TIERS == {TIERS}, "regenerate with the new tier count");\n\n')
+        f.write('const uint8_t wordle_answer_guesses[WORDLE_ANSWER_COUNT] = {\n')
+        for i in range(0, n, 32):
+            f.write('    ' + ','.join(str(g) for g in guesses[i:i + 32]) + ',\n')
+        f.write('};\n\n')
+        f.write('const uint16_t wordle_tier_answers[WORDLE_ANSWER_COUNT] = {\n')
+        for i in range(0, n, 16):
+            f.write('    ' + ','.join(str(a) for a in order[i:i + 16]) + ',\n')
+        f.write('};\n\n')
+        f.write('const uint16_t wordle_tier_start[WORDLE_TIERS + 1] = { '
+                + ', '.join(str(s) for s in starts) + ' };\n')
+
+    means = []
+    for t in range(TIERS):
+        tier = order[starts[t]:starts[t + 1]]
+        means.append(f'{sum(guesses[a] for a in tier) / len(tier):.2f}')
+    print(f'difficulty: {n} answers, mean {sum(guesses) / n:.2f} guesses, '
+          f'tiers {" / ".join(means)}')
+
+
+if __name__ == '__main__':
+    main()
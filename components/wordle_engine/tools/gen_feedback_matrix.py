@@ -0,0 +1,48 @@
+#!/usr/bin/env python3
+"""Precompute the guess x answer feedback matrix for the answer list.
+
+Row g, column a holds the base-3 feedback code (0..3^length - 1) of
+guessing wordle_answers[g] when the answer is wordle_answers[a], using the
+same rules as wordle_feedback(). Codes are one byte up to five letters and
+two (little-endian, like wordle_fb_t on the target) above.
+
+    gen_feedback_matrix.py answers.txt --length 5 --bin feedback_matrix_5.bin
+    gen_feedback_matrix.py answers.txt --length 5 --c feedback_matrix_5.c
+"""
+import argparse
+
+from wordlist import add_length_argument, code_bytes, feedback, read_words
+
+
+def build_matrix(words):
+    return [feedback(guess, answer) for guess in words for answer in words]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('answers_txt')
+    parser.add_argument('--bin', help='write the raw matrix for target_add_binary_data')
+    parser.add_argument('--c', help='write the matrix as a C array (host builds)')
+    add_length_argument(parser)
+    args = parser.parse_args()
+
+    words, _ = read_words(args.answers_txt, args.length)
+    matrix = build_matrix(words)
+    width = code_bytes(args.length)
+    if args.bin:
+        with open(args.bin, 'wb') as f:
+            f.write(b''.join(code.to_bytes(width, 'little') for code in matrix))
+    if args.c:
+        with open(args.c, 'w', encoding='utf-8') as f:
+            f.write('// Generated by gen_feedback_matrix.py, do not edit\n')
+            f.write(f'#define WORDLE_WORD_LEN {args.length}\n')
+            f.write('#include "wordle_fb_matrix.h"\n\n')
+            f.write(f'const wordle_fb_entry_t wordle_fb_matrix_data[{len(matrix)}] = {{\n')
+            for i in range(0, len(matrix), 24):
+                f.write('    ' + ','.join(str(b) for b in matrix[i:i + 24]) + ',\n')
+            f.write('};\n')
+    print(f'feedback matrix: {len(words)} x {len(words)} = {len(matrix) * width} bytes')
+
+
+if __name__ == '__main__':
+    main()
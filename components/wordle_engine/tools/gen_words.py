@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+"""Generate the answer table from words/<length>/answers.txt.
+
+Emits a header with the word count as a compile-time constant and a source
+file holding the answers as one flat table of packed words (one
+wordle_word_t each, no pointer table, no NUL terminators), plus per-letter
+answer counts the hint picker uses and the answer bitmasks candidate tracking
+is built from.
+
+    gen_words.py words/5/answers.txt --length 5 --header wordle_words_5.h --source wordle_words_5.c
+
+Every configured length gets its own pair. The header is for code compiled
+for that length (WORDLE_WORD_LEN, see wordle_feedback.h): it keeps the plain
+names, which map onto the length-suffixed symbols, so the tables of every
+length link side by side.
+"""
+import argparse
+
+from wordlist import add_length_argument, pack, read_words
+
+HEADER = '''// Generated by gen_words.py from {src}, do not edit
+#ifndef WORDLE_WORDS_{length}_H
+#define WORDLE_WORDS_{length}_H
+
+#include "wordle_feedback.h"
+
+#if WORDLE_WORD_LEN != {length}
+#error "wordle_words_{length}.h is for {length}-letter code"
+#endif
+
+#ifdef __cplusplus
+extern "C" {{
+#endif
+
+#define WORDLE_ANSWER_COUNT {count}
+
+#define wordle_answers           WORDLE_V(wordle_answers)
+#define wordle_letter_answers    WORDLE_V(wordle_letter_answers)
+#define wordle_position_answers  WORDLE_V(wordle_position_answers)
+#define wordle_position_masks    WORDLE_V(wordle_position_masks)
+#define wordle_repeat_masks      WORDLE_V(wordle_repeat_masks)
+
+// Answers sorted alphabetically, packed like wordle_pack()
+extern const wordle_word_t wordle_answers[WORDLE_ANSWER_COUNT];
+
+// Answers containing each letter, and answers with each letter at each
+// position: how far revealing a letter (or a letter and its place) narrows
+// the list
+extern const uint16_t wordle_letter_answers[26];
+extern const uint16_t wordle_position_answers[WORDLE_WORD_LEN][26];
+
+// Answer bitsets (bit i = wordle_answers[i]) that any guess's feedback
+// reduces to: answers with a letter at a position, and answers with at least
+// k copies of a letter ([letter][k - 1])
+#define WORDLE_CAND_WORDS   ((WORDLE_ANSWER_COUNT + 31) / 32)
+#define WORDLE_MAX_REPEAT   {max_repeat}
+
+extern const uint32_t wordle_position_masks[WORDLE_WORD_LEN][26][WORDLE_CAND_WORDS];
+extern const uint32_t wordle_repeat_masks[26][WORDLE_MAX_REPEAT][WORDLE_CAND_WORDS];
+
+#ifdef __cplusplus
+}}
+#endif
+
+#endif // WORDLE_WORDS_{length}_H
+'''
+
+
+def bitset(words, keep):
+    """C initializer for the answers matching keep, 32 per word, LSB first."""
+    values = [0] * ((len(words) + 31) // 32)
+    for i, w in enumerate(words):
+        if keep(w):
+            values[i // 32] |= 1 << (i % 32)
+    return ', '.join(f'0x{v:08x}' for v in values)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('answers_txt')
+    parser.add_argument('--header', required=True)
+    parser.add_argument('--source', required=True)
+    add_length_argument(parser)
+    args = parser.parse_args()
+
+    length = args.length
+    src = f'words/{length}/answers.txt'
+    words, duplicates = read_words(args.answers_txt, length)
+    max_repeat = max(w.count(c) for w in words for c in w)
+    digits = (5 * length + 3) // 4
+    per_row = 6 if length <= 5 else 4
+
+    with open(args.header, 'w', encoding='utf-8') as f:
+        f.write(HEADER.format(src=src, length=length, count=len(words), max_repeat=max_repeat))
+    with open(args.source, 'w', encoding='utf-8') as f:
+        f.write(f'// Generated by gen_words.py from {src}, do not edit\n')
+        f.write(f'#define WORDLE_WORD_LEN {length}\n')
+        f.write(f'#include "wordle_words_{length}.h"\n\n')
+        f.write('const wordle_word_t wordle_answers[WORDLE_ANSWER_COUNT] = {\n')
+        for i in range(0, len(words), per_row):
+            row = words[i:i + per_row]
+            f.write('    ' + ' '.join(f'0x{pack(w):0{digits}x},' for w in row).ljust(60)
+                    + ' // ' + ' '.join(row) + '\n')
+        f.write('};\n')
+
+        letters = [sum(1 for w in words if chr(65 + c) in w) for c in range(26)]
+        f.write('\nconst uint16_t wordle_letter_answers[26] = {\n')
+        f.write('    ' + ', '.join(str(n) for n in letters) + ',\n')
+        f.write('};\n')
+        f.write('\nconst uint16_t wordle_position_answers[WORDLE_WORD_LEN][26] = {\n')
+        for i in range(length):
+            counts = [sum(1 for w in words if w[i] == chr(65 + c)) for c in range(26)]
+            f.write('    { ' + ', '.join(str(n) for n in counts) + ' },\n')
+        f.write('};\n')
+
+        f.write('\nconst uint32_t wordle_position_masks[WORDLE_WORD_LEN][26][WORDLE_CAND_WORDS] = {\n')
+        for i in range(length):
+            f.write('    {\n')
+            for c in range(26):
+                f.write(f'        {{ {bitset(words, lambda w: w[i] == chr(65 + c))} }},\n')
+            f.write('    },\n')
+        f.write('};\n')
+
+        f.write('\nconst uint32_t wordle_repeat_masks[26][WORDLE_MAX_REPEAT][WORDLE_CAND_WORDS] = {\n')
+        for c in range(26):
+            f.write('    {\n')
+            for k in range(1, max_repeat + 1):
+                f.write(f'        {{ {bitset(words, lambda w: w.count(chr(65 + c)) >= k)} }},\n')
+            f.write('    },\n')
+        f.write('};\n')
+
+    note = f', {duplicates} duplicates dropped' if duplicates else ''
+    print(f'{len(words)} answers{note}')
+
+
+if __name__ == '__main__':
+    main()
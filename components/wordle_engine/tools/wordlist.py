@@ -0,0 +1,54 @@
+"""Word-list helpers shared by the build-time generators."""
+import sys
+
+
+def is_valid(word, length):
+    return len(word) == length and all('A' <= c <= 'Z' for c in word)
+
+
+def read_words(path, length):
+    """Read a whitespace separated word file and return its words, validated,
+    deduplicated and sorted. Exits with file:line on the first bad entry."""
+    words = set()
+    duplicates = 0
+    with open(path, encoding='utf-8') as f:
+        for lineno, line in enumerate(f, 1):
+            for word in line.split('#', 1)[0].split():
+                word = word.upper()
+                if not is_valid(word, length):
+                    sys.exit(f'{path}:{lineno}: "{word}" is not {length} letters A-Z')
+                duplicates += word in words
+                words.add(word)
+    return sorted(words), duplicates
+
+
+def add_length_argument(parser):
+    """--length, the build's CONFIG_WORDLE_WORD_LEN"""
+    parser.add_argument('--length', type=int, default=5, help='letters per word')
+
+
+def code_bytes(length):
+    """Bytes per feedback code, the size of wordle_fb_t"""
+    return 1 if 3 ** length <= 256 else 2
+
+
+def pack(word):
+    """Same layout as wordle_pack(): letter i in bits 5i..5i+4."""
+    return sum((ord(c) - ord('A')) << (5 * i) for i, c in enumerate(word))
+
+
+def feedback(guess, answer):
+    """Base-3 code, same rules as wordle_feedback(): greens first, then each
+    remaining guess letter takes one unmatched copy from the answer."""
+    result = [0] * len(guess)
+    unmatched = {}
+    for i in range(len(guess)):
+        if guess[i] == answer[i]:
+            result[i] = 2
+        else:
+            unmatched[answer[i]] = unmatched.get(answer[i], 0) + 1
+    for i in range(len(guess)):
+        if result[i] == 0 and unmatched.get(guess[i], 0):
+            unmatched[guess[i]] -= 1
+            result[i] = 1
+    return sum(r * 3 ** i for i, r in enumerate(result))
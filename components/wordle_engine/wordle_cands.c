@@ -0,0 +1,92 @@
+#include <string.h>
+#include "wordle_cands.h"
+
+void wordle_cands_reset(wordle_cands_t *cands)
+{
+    memset(cands->bits, 0xFF, WORDLE_CAND_WORDS * sizeof(cands->bits[0]));
+    if (WORDLE_ANSWER_COUNT % 32) {
+        cands->bits[WORDLE_CAND_WORDS - 1] = (1u << (WORDLE_ANSWER_COUNT % 32)) - 1;
+    }
+}
+
+static void and_mask(wordle_cands_t *cands, const uint32_t *mask)
+{
+    for (int w = 0; w < WORDLE_CAND_WORDS; w++) {
+        cands->bits[w] &= mask[w];
+    }
+}
+
+static void and_not_mask(wordle_cands_t *cands, const uint32_t *mask)
+{
+    for (int w = 0; w < WORDLE_CAND_WORDS; w++) {
+        cands->bits[w] &= ~mask[w];
+    }
+}
+
+// Answers with at least k copies of letter
+static void and_at_least(wordle_cands_t *cands, unsigned letter, int k)
+{
+    if (k > WORDLE_MAX_REPEAT) {
+        memset(cands->bits, 0, WORDLE_CAND_WORDS * sizeof(cands->bits[0]));
+    } else if (k > 0) {
+        and_mask(cands, wordle_repeat_masks[letter][k - 1]);
+    }
+}
+
+void wordle_cands_apply(wordle_cands_t *cands, wordle_word_t guess, wordle_fb_t code)
+{
+    int result[WORDLE_WORD_LEN];
+    wordle_fb_expand(code, result);
+
+    // Greens pin a letter, anything else rules the guessed letter out there
+    for (int i = 0; i < WORDLE_WORD_LEN; i++) {
+        const uint32_t *mask = wordle_position_masks[i][wordle_letter(guess, i)];
+        if (result[i] == 2) {
+            and_mask(cands, mask);
+        } else {
+            and_not_mask(cands, mask);
+        }
+    }
+
+    // Copies of each guessed letter: the answer has greens + yellows of it,
+    // exactly that many when one of its non-green copies came back grey
+    uint32_t done = 0;
+    for (int i = 0; i < WORDLE_WORD_LEN; i++) {
+        unsigned letter = wordle_letter(guess, i);
+        if (done & (1u << letter)) {
+            continue;
+        }
+        done |= 1u << letter;
+
+        int copies = 0;
+        bool grey_seen = false;
+        for (int j = i; j < WORDLE_WORD_LEN; j++) {
+            if (wordle_letter(guess, j) != letter) {
+                continue;
+            }
+            if (result[j] == 0) {
+                grey_seen = true;
+            } else if (result[j] == 1 && grey_seen) {
+                // Yellows go to the leftmost copies, no answer scores this
+                memset(cands->bits, 0, WORDLE_CAND_WORDS * sizeof(cands->bits[0]));
+                return;
+            } else {
+                copies++;
+            }
+        }
+
+        and_at_least(cands, letter, copies);
+        if (grey_seen && copies < WORDLE_MAX_REPEAT) {
+            and_not_mask(cands, wordle_repeat_masks[letter][copies]);
+        }
+    }
+}
+
+int wordle_cands_count(const wordle_cands_t *cands)
+{
+    int count = 0;
+    for (int w = 0; w < WORDLE_CAND_WORDS; w++) {
+        count += __builtin_popcount(cands->bits[w]);
+    }
+    return count;
+}
@@ -0,0 +1,71 @@
+#include <string.h>
+#include "wordle_deck.h"
+
+_Static_assert(CONFIG_WORDLE_DIFFICULTY >= 0 && CONFIG_WORDLE_DIFFICULTY <= WORDLE_TIERS,
+               "difficulty is 0 (rotate) or a tier number");
+
+// Stream for one pass of one tier, so any pass can be rebuilt from the seed
+static uint32_t pass_state(uint32_t seed, int tier, uint32_t pass)
+{
+    uint32_t x = seed ^ (uint32_t)tier * 0x9E3779B9u ^ pass * 0x85EBCA6Bu;
+    return x ? x : 1;  // xorshift32 never leaves 0
+}
+
+static uint32_t xorshift32(uint32_t *x)
+{
+    *x ^= *x << 13;
+    *x ^= *x >> 17;
+    *x ^= *x << 5;
+    return *x;
+}
+
+// Fisher-Yates over the tier's segment, from its sorted order
+static void shuffle_tier(wordle_deck_t *deck, int tier)
+{
+    int start = wordle_tier_start[tier];
+    int n = wordle_tier_start[tier + 1] - start;
+    uint16_t *cards = &deck->cards[start];
+    uint32_t x = pass_state(deck->pos.seed, tier, deck->pos.pass[tier]);
+
+    memcpy(cards, &wordle_tier_answers[start], n * sizeof(cards[0]));
+    for (int i = n - 1; i > 0; i--) {
+        int j = (int)(((uint64_t)xorshift32(&x) * (uint32_t)(i + 1)) >> 32);
+        uint16_t t = cards[i];
+        cards[i] = cards[j];
+        cards[j] = t;
+    }
+}
+
+void wordle_deck_init(wordle_deck_t *deck, uint32_t seed)
+{
+    memset(&deck->pos, 0, sizeof(deck->pos));
+    deck->pos.seed = seed;
+    for (int t = 0; t < WORDLE_TIERS; t++) {
+        shuffle_tier(deck, t);
+    }
+}
+
+bool wordle_deck_restore(wordle_deck_t *deck, const wordle_deck_pos_t *pos)
+{
+    for (int t = 0; t < WORDLE_TIERS; t++) {
+        if (pos->dealt[t] > wordle_tier_start[t + 1] - wordle_tier_start[t]) {
+            return false;
+        }
+    }
+    deck->pos = *pos;
+    for (int t = 0; t < WORDLE_TIERS; t++) {
+        shuffle_tier(deck, t);
+    }
+    return true;
+}
+
+uint16_t wordle_deck_draw(wordle_deck_t *deck, wordle_tier_t tier)
+{
+    int n = wordle_tier_start[tier + 1] - wordle_tier_start[tier];
+    if (deck->pos.dealt[tier] >= n) {
+        deck->pos.pass[tier]++;
+        deck->pos.dealt[tier] = 0;
+        shuffle_tier(deck, tier);
+    }
+    return deck->cards[wordle_tier_start[tier] + deck->pos.dealt[tier]++];
+}
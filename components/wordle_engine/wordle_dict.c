@@ -0,0 +1,15 @@
+#include "wordle_dict.h"
+
+bool wordle_dict_contains(wordle_word_t word)
+{
+    // Descend the implicit tree: left child 2k, right child 2k+1. The
+    // comparison feeds the index instead of a branch.
+    size_t k = 1;
+    while (k <= wordle_dict_count) {
+        k = 2 * k + (wordle_dict_tree[k] < word);
+    }
+    // Undo the trailing right turns plus one left turn to land on the lower
+    // bound; k == 0 means every key is smaller than word.
+    k >>= __builtin_ffs(~(unsigned)k);
+    return k != 0 && wordle_dict_tree[k] == word;
+}
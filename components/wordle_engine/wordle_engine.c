@@ -0,0 +1,533 @@
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+#include "wordle_engine.h"
+#include "wordle_trace.h"
+
+static const char *TAG = "wordle engine";
+
+// Descriptors from gen/wordle_variant_<length>.c, one per length built
+#if WORDLE_HAVE_4
+extern const wordle_variant_t wordle_variant_4;
+#endif
+#if WORDLE_HAVE_5
+extern const wordle_variant_t wordle_variant_5;
+#endif
+#if WORDLE_HAVE_6
+extern const wordle_variant_t wordle_variant_6;
+#endif
+#if WORDLE_HAVE_7
+extern const wordle_variant_t wordle_variant_7;
+#endif
+
+const wordle_variant_t *const wordle_variants[WORDLE_VARIANT_COUNT] = {
+#if WORDLE_HAVE_4
+    &wordle_variant_4,
+#endif
+#if WORDLE_HAVE_5
+    &wordle_variant_5,
+#endif
+#if WORDLE_HAVE_6
+    &wordle_variant_6,
+#endif
+#if WORDLE_HAVE_7
+    &wordle_variant_7,
+#endif
+};
+
+const wordle_variant_t *wordle_variant_get(int word_len)
+{
+    for (int v = 0; v < WORDLE_VARIANT_COUNT; v++) {
+        if (wordle_variants[v]->word_len == word_len) {
+            return wordle_variants[v];
+        }
+    }
+    return NULL;
+}
+
+void wordle_game_init(game_state_t *game, wordle_send_fn send, void *send_ctx)
+{
+    memset(game, 0, sizeof(*game));
+    game->hint_player = -1;
+    game->send = send;
+    game->send_ctx = send_ctx;
+    game->variant = WORDLE_DEFAULT_VARIANT;
+}
+
+void wordle_game_set_deadline(game_state_t *game, wordle_deadline_fn deadline, void *ctx)
+{
+    game->deadline = deadline;
+    game->deadline_ctx = ctx;
+}
+
+void wordle_game_set_watch(game_state_t *game, wordle_watch_fn watch, void *ctx)
+{
+    game->watch = watch;
+    game->watch_ctx = ctx;
+}
+
+void wordle_game_set_variant(game_state_t *game, const wordle_variant_t *variant, wordle_deck_t *deck)
+{
+    game->variant = variant;
+    game->deck = deck;
+}
+
+void wordle_game_reset(game_state_t *game)
+{
+    wordle_deadline_fn deadline = game->deadline;
+    void *deadline_ctx = game->deadline_ctx;
+    wordle_watch_fn watch = game->watch;
+    void *watch_ctx = game->watch_ctx;
+    const wordle_variant_t *variant = game->variant;
+    wordle_deck_t *deck = game->deck;
+
+    wordle_game_init(game, game->send, game->send_ctx);
+    wordle_game_set_deadline(game, deadline, deadline_ctx);
+    wordle_game_set_watch(game, watch, watch_ctx);
+    wordle_game_set_variant(game, variant, deck);
+}
+
+// Start (delay_ms > 0) or cancel the turn timer
+static void arm_deadline(game_state_t *game, uint32_t delay_ms)
+{
+    if (game->deadline != NULL) {
+        game->deadline(game->deadline_ctx, game, delay_ms);
+    }
+}
+
+// Send a message to a specific player
+static void send_to_player(game_state_t *game, int player_index, const wordle_msg_t *msg)
+{
+    if (!game->players[player_index].connected || game->players[player_index].away) {
+        return;  // Player not connected, or waiting to reconnect
+    }
+    if (game->send != NULL) {
+        game->send(game->send_ctx, game->players[player_index].fd, msg);
+    }
+}
+
+// Hand a message to the spectators, once
+static void send_to_watchers(game_state_t *game, const wordle_msg_t *msg)
+{
+    if (game->watch != NULL) {
+        game->watch(game->watch_ctx, game, msg);
+    }
+}
+
+// Broadcast a message to all connected players, and whoever is watching
+static void broadcast_to_all(game_state_t *game, const wordle_msg_t *msg)
+{
+    for (int i = 0; i < WORDLE_MAX_PLAYERS; i++) {
+        if (game->players[i].connected) {
+            send_to_player(game, i, msg);
+        }
+    }
+    send_to_watchers(game, msg);
+}
+
+// Initialize a new round
+void wordle_start_new_round(game_state_t *game)
+{
+    const wordle_variant_t *v = game->variant;
+    game->first_round_pending = false;
+    game->round_number++;
+    game->round_over = false;
+    game->round_start_time = time(NULL);
+
+    // Reset player states for new round
+    for (int i = 0; i < WORDLE_MAX_PLAYERS; i++) {
+        if (game->players[i].connected) {
+            game->players[i].guesses_used = 0;
+            game->players[i].has_won = false;
+            game->players[i].waiting_for_opponent = false;
+            v->cands_reset(&game->players[i].cands);
+            game->players[i].remaining = v->answer_count;
+            game->players[i].row_count = 0;
+        }
+    }
+
+    // Next word from the round's tier; bare games (benchmarks) pick at random
+    if (game->deck != NULL) {
+        game->target_index = v->deck_draw(game->deck, wordle_round_tier(game->round_number));
+    } else {
+        game->target_index = rand() % v->answer_count;
+    }
+    game->target_packed = v->answers[game->target_index];
+    v->unpack(game->target_packed, game->target_word);
+
+    WORDLE_TRACE(WORDLE_TRACE_GAME, WORDLE_EV_ROUND_START, -1, v->word_len << 24 | game->round_number,
+                 game->target_index);
+
+     // Calculate hints based on CURRENT scores and NEW word
+    int score_diff = abs(game->players[0].score - game->players[1].score);
+    int losing_player = -1;
+
+    if (game->players[0].score < game->players[1].score) {
+        losing_player = 0;
+    } else if (game->players[1].score < game->players[0].score) {
+        losing_player = 1;
+    }
+
+    // Send round start message to both players
+    wordle_msg_t msg = { .type = WORDLE_MSG_ROUND_START, .variant = game->variant };
+    msg.round_start.round = game->round_number;
+    msg.round_start.time_limit = WORDLE_TIME_LIMIT;
+    msg.round_start.hint_player = -1;
+    game->hint_player = -1;
+
+     // Add hint for losing player (from NEW word)
+    if (losing_player >= 0 && score_diff >= WORDLE_HINT_MIN_GAP) {
+        wordle_hint_t hint;
+        v->hint_pick(game->target_packed, score_diff, &hint);
+        game->hint_player = losing_player;
+        game->hint = hint;
+
+        msg.round_start.hint_player = losing_player;
+        msg.round_start.hint_position = hint.position;
+        msg.round_start.hint_letter = hint.letter;
+        msg.round_start.hint_green = hint.green;
+
+        WORDLE_TRACE(WORDLE_TRACE_GAME, WORDLE_EV_HINT, game->players[losing_player].fd, losing_player,
+                     hint.green << 16 | hint.position << 8 | hint.letter);
+    }
+
+    broadcast_to_all(game, &msg);
+    arm_deadline(game, WORDLE_TURN_MS);
+}
+
+// End the current round and determine winner
+void wordle_end_round(game_state_t *game)
+{
+    if (game->round_over) return; // Already ended
+
+    game->round_over = true;
+    arm_deadline(game, 0);
+
+    // Determine winner(s)
+    int winner = -1;  // -1 = tie/no winner, 0 = player 1, 1 = player 2
+
+    // Check if anyone won
+    bool p1_won = game->players[0].connected && game->players[0].has_won;
+    bool p2_won = game->players[1].connected && game->players[1].has_won;
+
+    if (p1_won && p2_won) {
+        // Both won - check who used fewer guesses
+        if (game->players[0].guesses_used < game->players[1].guesses_used) {
+            winner = 0;
+            game->players[0].score++;
+        } else if (game->players[1].guesses_used < game->players[0].guesses_used) {
+            winner = 1;
+            game->players[1].score++;
+        } else {
+            winner = -1; // Tie - same number of guesses
+        }
+    } else if (p1_won) {
+        winner = 0;
+        game->players[0].score++;
+    } else if (p2_won) {
+        winner = 1;
+        game->players[1].score++;
+    }
+
+    // Send round results to both players
+    wordle_msg_t msg = { .type = WORDLE_MSG_ROUND_END, .variant = game->variant };
+    msg.round_end.winner = winner;
+    strcpy(msg.round_end.target_word, game->target_word);
+    msg.round_end.player1_score = game->players[0].score;
+    msg.round_end.player2_score = game->players[1].score;
+    WORDLE_TRACE(WORDLE_TRACE_GAME, WORDLE_EV_ROUND_END, -1, game->round_number, winner);
+
+    broadcast_to_all(game, &msg);
+}
+
+// Find a free player slot and add the connection
+int wordle_add_player(game_state_t *game, int fd)
+{
+    for (int i = 0; i < WORDLE_MAX_PLAYERS; i++) {
+        if (!game->players[i].connected) {
+            game->players[i].fd = fd;
+            game->players[i].connected = true;
+            game->players[i].name[0] = '\0';  // Not joined, whoever sat here before
+            game->player_count++;
+            ESP_LOGI(TAG, "Player %d joined. Total players: %d", i + 1, game->player_count);
+            return i;  // Return player index (0 or 1)
+        }
+    }
+    return -1;  // No slots available
+}
+
+// Remove a player when they disconnect
+void wordle_remove_player(game_state_t *game, int fd)
+{
+    int i = wordle_find_player(game, fd);
+    if (i >= 0) {
+        wordle_remove_slot(game, i);
+    }
+}
+
+void wordle_remove_slot(game_state_t *game, int i)
+{
+    if (!game->players[i].connected) {
+        return;
+    }
+
+    game->players[i].connected = false;
+    game->players[i].away = false;
+    game->players[i].token = 0;
+    game->player_count--;
+    ESP_LOGI(TAG, "Player %d left. Total players: %d", i + 1, game->player_count);
+
+    // If a player leaves, end the game
+    if (game->game_active) {
+        game->game_active = false;
+        arm_deadline(game, 0);
+        ESP_LOGI(TAG, "Game ended because player left");
+    }
+}
+
+// Map a socket back to its player slot, -1 if the fd is not playing
+int wordle_find_player(const game_state_t *game, int fd)
+{
+    for (int i = 0; i < WORDLE_MAX_PLAYERS; i++) {
+        if (game->players[i].connected && !game->players[i].away && game->players[i].fd == fd) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void wordle_send_welcome(game_state_t *game, int player_index)
+{
+    wordle_msg_t welcome = { .type = WORDLE_MSG_WELCOME, .variant = game->variant };
+    welcome.welcome.player_index = player_index;
+    welcome.welcome.token = game->players[player_index].token;
+    send_to_player(game, player_index, &welcome);
+}
+
+// Both players are in for this turn, by guessing or timing out: advance to the
+// next guess or end the round
+static void complete_turn(game_state_t *game)
+{
+    // Reset waiting flags for next guess
+    game->players[0].waiting_for_opponent = false;
+    game->players[1].waiting_for_opponent = false;
+    WORDLE_TRACE(WORDLE_TRACE_GAME, WORDLE_EV_TURN_DONE, -1, game->round_number,
+                 game->players[0].guesses_used << 8 | game->players[1].guesses_used);
+
+    // Broadcast both results to both players
+    wordle_msg_t both_results = { .type = WORDLE_MSG_BOTH_GUESSED, .variant = game->variant };
+    broadcast_to_all(game, &both_results);
+
+    // Check if round should end
+    if (game->players[0].has_won || game->players[1].has_won) {
+        wordle_end_round(game);
+    } else if (game->players[0].guesses_used >= game->variant->max_guesses &&
+               game->players[1].guesses_used >= game->variant->max_guesses) {
+        wordle_end_round(game);
+    } else {
+        arm_deadline(game, WORDLE_TURN_MS);  // Fresh clock for the next guess
+    }
+}
+
+bool wordle_handle_join(game_state_t *game, int player_index, const char *name)
+{
+    strncpy(game->players[player_index].name, name, 31);
+    game->players[player_index].name[31] = '\0';
+    ESP_LOGI(TAG, "Player %d (%s) joined the lobby", player_index + 1, name);
+
+    // Send lobby update to all players
+    wordle_msg_t lobby_msg = { .type = WORDLE_MSG_LOBBY_UPDATE, .variant = game->variant };
+    lobby_msg.lobby_update.player_count = game->player_count;
+    broadcast_to_all(game, &lobby_msg);
+
+    // Check if both players have names (both clicked join)
+    bool both_ready = (strlen(game->players[0].name) > 0 &&
+                    strlen(game->players[1].name) > 0 &&
+                    game->players[0].connected &&
+                    game->players[1].connected);
+
+    if (!both_ready || game->player_count != 2) {
+        return false;
+    }
+
+    ESP_LOGI(TAG, "Both players ready! Starting game...");
+
+    // Send game_starting message
+    wordle_msg_t start_msg = { .type = WORDLE_MSG_GAME_STARTING, .variant = game->variant };
+    broadcast_to_all(game, &start_msg);
+
+    game->game_active = true;
+    game->first_round_pending = true;
+    return true;
+}
+
+bool wordle_start_first_round(game_state_t *game)
+{
+    if (!game->first_round_pending || !game->game_active || game->player_count != WORDLE_MAX_PLAYERS) {
+        return false;
+    }
+    wordle_start_new_round(game);
+    return true;
+}
+
+// Guesses while waiting for the opponent or after the round are dropped
+// without a reply
+static bool guess_ignored(const game_state_t *game, int player_index)
+{
+    const player_t *player = &game->players[player_index];
+
+    // Nothing to guess at before round 1 has its word
+    if (!game->game_active || game->first_round_pending) {
+        WORDLE_TRACE(WORDLE_TRACE_GAME, WORDLE_EV_GUESS_IGNORED, player->fd, player_index, 2);
+        return true;
+    }
+
+    // Check if they're already waiting or round is over
+    if (player->waiting_for_opponent) {
+        WORDLE_TRACE(WORDLE_TRACE_GAME, WORDLE_EV_GUESS_IGNORED, player->fd, player_index, 0);
+        return true;
+    }
+
+    if (game->round_over || player->has_won) {
+        WORDLE_TRACE(WORDLE_TRACE_GAME, WORDLE_EV_GUESS_IGNORED, player->fd, player_index, 1);
+        return true;
+    }
+    return false;
+}
+
+// Words we don't know are turned back before they cost a turn
+static void reject_guess(game_state_t *game, int player_index, const char *guess)
+{
+    WORDLE_TRACE(WORDLE_TRACE_GAME, WORDLE_EV_INVALID_GUESS, game->players[player_index].fd, player_index, 0);
+
+    // The initializer zero-fills the word, so a short guess stays NUL padded
+    wordle_msg_t invalid = { .type = WORDLE_MSG_INVALID_GUESS, .variant = game->variant };
+    memcpy(invalid.invalid_guess.word, guess, strnlen(guess, game->variant->word_len));
+    send_to_player(game, player_index, &invalid);
+}
+
+// A whole-word guess from either entry point: score it, unless it is not in
+// the dictionary
+static void play_guess(game_state_t *game, int player_index, wordle_word_t packed)
+{
+    const wordle_variant_t *v = game->variant;
+    player_t *player = &game->players[player_index];
+    char guess[WORDLE_MAX_WORD_LEN + 1];
+    v->unpack(packed, guess);
+    if (!v->dict_contains(packed)) {
+        reject_guess(game, player_index, guess);
+        return;
+    }
+
+    player->guesses_used++;
+    player->waiting_for_opponent = true;
+
+    // Check the guess
+    wordle_fb_t code = v->feedback(packed, game->target_packed);
+    bool is_correct = (code == v->all_green);
+    v->cands_apply(&player->cands, packed, code);
+    player->remaining = v->cands_count(&player->cands);
+    if (player->row_count < v->max_guesses) {
+        player->rows[player->row_count] = packed;
+        player->codes[player->row_count] = code;
+        player->row_count++;
+    }
+    // b holds the low 32 bits of the word. Seven-letter words are 35 bits,
+    // so the top 3 go in bits 24+ of a, above the code (bits 8-23) and slot,
+    // and the length in bits 28+.
+    WORDLE_TRACE(WORDLE_TRACE_GAME, WORDLE_EV_GUESS, player->fd,
+                 (int32_t)((uint32_t)v->word_len << 28 | (uint64_t)packed >> 32 << 24 | code << 8 | player_index),
+                 (int32_t)packed);
+
+    wordle_msg_t response = { .type = WORDLE_MSG_RESULT, .variant = game->variant };
+    response.result.code = code;
+    response.result.packed = packed;
+
+    if (is_correct) {
+        player->has_won = true;
+    }
+
+    // Send result to this player
+    memcpy(response.result.word, guess, sizeof(response.result.word));
+    response.result.player = player_index;
+    response.result.is_correct = is_correct;
+    send_to_player(game, player_index, &response);
+    send_to_watchers(game, &response);
+
+    // Notify opponent that this player submitted
+    int opponent_index = (player_index == 0) ? 1 : 0;
+    wordle_msg_t waiting_msg = { .type = WORDLE_MSG_OPPONENT_SUBMITTED, .variant = game->variant };
+    waiting_msg.opponent_submitted.opponent = player_index;
+    waiting_msg.opponent_submitted.remaining = player->remaining;
+    send_to_player(game, opponent_index, &waiting_msg);
+
+    // Check if both players have submitted
+    bool both_submitted = game->players[0].waiting_for_opponent &&
+                        game->players[1].waiting_for_opponent;
+
+    if (both_submitted) {
+        complete_turn(game);
+    }
+}
+
+void wordle_handle_guess(game_state_t *game, int player_index, const char *guess)
+{
+    if (guess_ignored(game, player_index)) {
+        return;
+    }
+    wordle_word_t packed;
+    if (!game->variant->pack(guess, &packed)) {
+        reject_guess(game, player_index, guess);
+        return;
+    }
+    play_guess(game, player_index, packed);
+}
+
+void wordle_handle_packed_guess(game_state_t *game, int player_index, wordle_word_t packed, int word_len)
+{
+    if (guess_ignored(game, player_index)) {
+        return;
+    }
+    if (word_len != game->variant->word_len) {
+        // Letters A-Z, so unpacking at the word's own length gives it back
+        char guess[WORDLE_MAX_WORD_LEN + 1];
+        for (int i = 0; i < word_len; i++) {
+            guess[i] = (char)('A' + wordle_letter(packed, i));
+        }
+        guess[word_len] = '\0';
+        reject_guess(game, player_index, guess);
+        return;
+    }
+    play_guess(game, player_index, packed);
+}
+
+void wordle_handle_next_round(game_state_t *game)
+{
+    WORDLE_TRACE(WORDLE_TRACE_GAME, WORDLE_EV_NEXT_ROUND, -1, game->round_over, 0);
+
+    if (game->round_over) {
+        wordle_start_new_round(game);
+    }
+}
+
+void wordle_handle_deadline(game_state_t *game)
+{
+    if (!game->game_active || game->round_over) {
+        return;
+    }
+
+    // Force submit for any player who hasn't guessed; the skipped guess counts
+    for (int i = 0; i < WORDLE_MAX_PLAYERS; i++) {
+        player_t *player = &game->players[i];
+        if (player->connected && !player->waiting_for_opponent && !player->has_won) {
+            WORDLE_TRACE(WORDLE_TRACE_GAME, WORDLE_EV_TIMEOUT, player->fd, i, 0);
+            player->guesses_used++;
+            player->waiting_for_opponent = true;
+
+            wordle_msg_t timeout = { .type = WORDLE_MSG_TIMEOUT, .variant = game->variant };
+            send_to_player(game, i, &timeout);
+        }
+    }
+
+    complete_turn(game);
+}
@@ -0,0 +1,25 @@
+#include "wordle_fb_matrix.h"
+
+#define WORDLE_STR_(x) #x
+#define WORDLE_STR(x) WORDLE_STR_(x)
+
+#if WORDLE_V(WORDLE_FB_MATRIX)
+#ifdef ESP_PLATFORM
+// Embedded by target_add_binary_data, same mechanism as the web assets
+// (little-endian codes, the target's own order when they are two bytes)
+extern const wordle_fb_entry_t fb_matrix_start[]
+    asm("_binary_feedback_matrix_" WORDLE_STR(WORDLE_WORD_LEN) "_bin_start");
+#else
+// Host builds compile the matrix as a C array instead
+extern const wordle_fb_entry_t wordle_fb_matrix_data[];
+#define fb_matrix_start wordle_fb_matrix_data
+#endif
+const wordle_fb_entry_t *const wordle_fb_matrix = fb_matrix_start;
+#else
+const wordle_fb_entry_t *const wordle_fb_matrix = NULL;
+#endif
+
+size_t wordle_fb_matrix_bytes(void)
+{
+    return wordle_fb_matrix ? (size_t)WORDLE_ANSWER_COUNT * WORDLE_ANSWER_COUNT * sizeof(wordle_fb_entry_t) : 0;
+}
@@ -0,0 +1,34 @@
+#include "wordle_feedback.h"
+
+bool wordle_pack(const char *word, wordle_word_t *out)
+{
+    wordle_word_t packed = 0;
+    for (int i = 0; i < WORDLE_WORD_LEN; i++) {
+        char c = word[i];
+        if (c < 'A' || c > 'Z') {
+            return false;  // Also catches a NUL in short strings
+        }
+        packed |= (wordle_word_t)(c - 'A') << (5 * i);
+    }
+    if (word[WORDLE_WORD_LEN] != '\0') {
+        return false;
+    }
+    *out = packed;
+    return true;
+}
+
+void wordle_unpack(wordle_word_t word, char *out)
+{
+    for (int i = 0; i < WORDLE_WORD_LEN; i++) {
+        out[i] = (char)('A' + wordle_letter(word, i));
+    }
+    out[WORDLE_WORD_LEN] = '\0';
+}
+
+void wordle_fb_expand(wordle_fb_t code, int *result)
+{
+    for (int i = 0; i < WORDLE_WORD_LEN; i++) {
+        result[i] = code % 3;
+        code /= 3;
+    }
+}
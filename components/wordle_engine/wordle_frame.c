@@ -0,0 +1,77 @@
+#include "wordle_frame.h"
+#include "wordle_pool.h"
+
+#ifdef ESP_PLATFORM
+#include "freertos/FreeRTOS.h"
+static portMUX_TYPE frameq_lock = portMUX_INITIALIZER_UNLOCKED;
+#define FRAMEQ_LOCK()   portENTER_CRITICAL(&frameq_lock)
+#define FRAMEQ_UNLOCK() portEXIT_CRITICAL(&frameq_lock)
+#else
+// Host builds are single threaded
+#define FRAMEQ_LOCK()
+#define FRAMEQ_UNLOCK()
+#endif
+
+_Static_assert((WORDLE_FRAMEQ_LEN & (WORDLE_FRAMEQ_LEN - 1)) == 0, "queue length must be a power of two");
+
+wordle_frame_t *wordle_frame_alloc(size_t len, bool binary)
+{
+    wordle_frame_t *frame = wordle_pool_malloc(sizeof(wordle_frame_t) + len);
+    if (frame == NULL) {
+        return NULL;
+    }
+    frame->refs = 1;
+    frame->len = (uint16_t)len;
+    frame->binary = binary;
+    return frame;
+}
+
+wordle_frame_t *wordle_frame_ref(wordle_frame_t *frame)
+{
+    __atomic_fetch_add(&frame->refs, 1, __ATOMIC_RELAXED);
+    return frame;
+}
+
+void wordle_frame_unref(wordle_frame_t *frame)
+{
+    if (frame != NULL && __atomic_sub_fetch(&frame->refs, 1, __ATOMIC_ACQ_REL) == 0) {
+        wordle_pool_free(frame);
+    }
+}
+
+bool wordle_frameq_push(wordle_frameq_t *q, wordle_frame_t *frame)
+{
+    FRAMEQ_LOCK();
+    if ((uint16_t)(q->tail - q->head) == WORDLE_FRAMEQ_LEN) {
+        q->dropped++;
+        FRAMEQ_UNLOCK();
+        return false;
+    }
+    q->frames[q->tail % WORDLE_FRAMEQ_LEN] = wordle_frame_ref(frame);
+    q->tail++;
+    FRAMEQ_UNLOCK();
+    return true;
+}
+
+wordle_frame_t *wordle_frameq_pop(wordle_frameq_t *q)
+{
+    wordle_frame_t *frame = NULL;
+    FRAMEQ_LOCK();
+    if (q->head != q->tail) {
+        frame = q->frames[q->head % WORDLE_FRAMEQ_LEN];
+        q->head++;
+    }
+    FRAMEQ_UNLOCK();
+    return frame;
+}
+
+void wordle_frameq_clear(wordle_frameq_t *q)
+{
+    wordle_frame_t *frame;
+    while ((frame = wordle_frameq_pop(q)) != NULL) {
+        wordle_frame_unref(frame);
+    }
+    FRAMEQ_LOCK();
+    q->dropped = 0;
+    FRAMEQ_UNLOCK();
+}
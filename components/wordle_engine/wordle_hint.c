@@ -0,0 +1,23 @@
+#include <math.h>
+#include "wordle_hint.h"
+#include "wordle_words.h"
+
+void wordle_hint_pick(wordle_word_t target, int score_gap, wordle_hint_t *hint)
+{
+    bool green = score_gap >= WORDLE_HINT_GREEN_GAP;
+    float want = log2f((float)score_gap + 1.0f);  // Bits the hint should be worth
+
+    float best_error = INFINITY;
+    for (int i = 0; i < WORDLE_WORD_LEN; i++) {
+        unsigned letter = wordle_letter(target, i);
+        uint16_t remaining = green ? wordle_position_answers[i][letter] : wordle_letter_answers[letter];
+        float bits = log2f((float)WORDLE_ANSWER_COUNT / remaining);
+        if (fabsf(bits - want) < best_error) {
+            best_error = fabsf(bits - want);
+            hint->position = i;
+            hint->letter = (char)('A' + letter);
+            hint->remaining = remaining;
+        }
+    }
+    hint->green = green;
+}
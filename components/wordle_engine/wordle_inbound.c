@@ -0,0 +1,307 @@
+#include <stdint.h>
+#include <string.h>
+#include "wordle_inbound.h"
+
+// Message types by perfect hash: (length * 3 + first + last character) & 7
+// gives each name its own slot, so a lookup is one hash and one memcmp. A new
+// type has to land in a free slot (or the multiplier changes); the proto
+// bench parses every type and fails loudly when one is not recognised.
+#define TYPE_SLOTS 8
+
+typedef struct {
+    const char *name;
+    uint8_t len;
+    wordle_in_type_t type;
+} type_entry_t;
+
+static const type_entry_t types[TYPE_SLOTS] = {
+    [0] = { "next_round", 10, WORDLE_IN_NEXT_ROUND },
+    [1] = { "guess",      5,  WORDLE_IN_GUESS },
+    [4] = { "join",       4,  WORDLE_IN_JOIN },
+};
+
+static wordle_in_type_t lookup_type(const char *s, size_t len)
+{
+    if (len == 0) {
+        return WORDLE_IN_NONE;
+    }
+    const type_entry_t *e = &types[(len * 3 + (uint8_t)s[0] + (uint8_t)s[len - 1]) & (TYPE_SLOTS - 1)];
+    if (e->name != NULL && e->len == len && memcmp(e->name, s, len) == 0) {
+        return e->type;
+    }
+    return WORDLE_IN_NONE;
+}
+
+typedef struct {
+    char *p;
+    char *end;
+} scan_t;
+
+static void skip_ws(scan_t *s)
+{
+    while (s->p < s->end && (*s->p == ' ' || *s->p == '\t' || *s->p == '\n' || *s->p == '\r')) {
+        s->p++;
+    }
+}
+
+static int hex_digit(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static bool read_hex4(scan_t *s, uint32_t *out)
+{
+    if (s->end - s->p < 4) {
+        return false;
+    }
+    uint32_t v = 0;
+    for (int i = 0; i < 4; i++) {
+        int d = hex_digit(s->p[i]);
+        if (d < 0) {
+            return false;
+        }
+        v = v << 4 | (uint32_t)d;
+    }
+    s->p += 4;
+    *out = v;
+    return true;
+}
+
+// Decoded output is never longer than the escape it came from, so strings
+// are decoded over themselves
+static char *put_utf8(char *out, uint32_t cp)
+{
+    if (cp < 0x80) {
+        *out++ = (char)cp;
+    } else if (cp < 0x800) {
+        *out++ = (char)(0xC0 | cp >> 6);
+        *out++ = (char)(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        *out++ = (char)(0xE0 | cp >> 12);
+        *out++ = (char)(0x80 | (cp >> 6 & 0x3F));
+        *out++ = (char)(0x80 | (cp & 0x3F));
+    } else {
+        *out++ = (char)(0xF0 | cp >> 18);
+        *out++ = (char)(0x80 | (cp >> 12 & 0x3F));
+        *out++ = (char)(0x80 | (cp >> 6 & 0x3F));
+        *out++ = (char)(0x80 | (cp & 0x3F));
+    }
+    return out;
+}
+
+// String at s->p (past the opening quote), decoded in place and
+// NUL-terminated. Returns its start and sets *len, NULL when malformed.
+static char *read_string(scan_t *s, size_t *len)
+{
+    char *start = s->p;
+    char *out = s->p;
+    while (s->p < s->end) {
+        char c = *s->p++;
+        if (c == '"') {
+            *out = '\0';   // At most where the closing quote was
+            *len = (size_t)(out - start);
+            return start;
+        }
+        if ((unsigned char)c < 0x20) {
+            return NULL;
+        }
+        if (c != '\\') {
+            *out++ = c;
+            continue;
+        }
+        if (s->p == s->end) {
+            return NULL;
+        }
+        c = *s->p++;
+        switch (c) {
+        case '"': case '\\': case '/': *out++ = c; break;
+        case 'b': *out++ = '\b'; break;
+        case 'f': *out++ = '\f'; break;
+        case 'n': *out++ = '\n'; break;
+        case 'r': *out++ = '\r'; break;
+        case 't': *out++ = '\t'; break;
+        case 'u': {
+            uint32_t cp;
+            if (!read_hex4(s, &cp)) {
+                return NULL;
+            }
+            if (cp >= 0xD800 && cp < 0xDC00) {
+                // High surrogate, its low half should follow
+                uint32_t lo;
+                if (s->end - s->p >= 6 && s->p[0] == '\\' && s->p[1] == 'u') {
+                    s->p += 2;
+                    if (!read_hex4(s, &lo)) {
+                        return NULL;
+                    }
+                    cp = (lo >= 0xDC00 && lo < 0xE000) ? 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00) : 0xFFFD;
+                } else {
+                    cp = 0xFFFD;
+                }
+            } else if (cp >= 0xDC00 && cp < 0xE000) {
+                cp = 0xFFFD;
+            }
+            out = put_utf8(out, cp);
+            break;
+        }
+        default:
+            return NULL;
+        }
+    }
+    return NULL;
+}
+
+// Step over a value we have no use for: a string, a nested object or array,
+// or a literal/number
+static bool skip_value(scan_t *s)
+{
+    int depth = 0;
+    do {
+        if (s->p == s->end) {
+            return false;
+        }
+        char c = *s->p;
+        if (c == '"') {
+            s->p++;
+            size_t len;
+            if (read_string(s, &len) == NULL) {
+                return false;
+            }
+        } else if (c == '{' || c == '[') {
+            depth++;
+            s->p++;
+        } else if (c == '}' || c == ']') {
+            if (depth == 0) {
+                return false;
+            }
+            depth--;
+            s->p++;
+        } else if (depth > 0) {
+            s->p++;   // Commas, colons, whitespace and literals inside
+        } else {
+            char *start = s->p;
+            while (s->p < s->end && *s->p != ',' && *s->p != '}' && *s->p != ']' &&
+                   *s->p != ' ' && *s->p != '\t' && *s->p != '\n' && *s->p != '\r') {
+                s->p++;
+            }
+            if (s->p == start) {
+                return false;
+            }
+        }
+    } while (depth > 0);
+    return true;
+}
+
+static bool match_literal(scan_t *s, const char *lit, size_t len)
+{
+    if ((size_t)(s->end - s->p) >= len && memcmp(s->p, lit, len) == 0) {
+        s->p += len;
+        return true;
+    }
+    return false;
+}
+
+// Same rules as wordle_pack(), checked while the frame is being scanned, for
+// any length a room can play
+static bool pack_word(const char *word, size_t len, wordle_word_t *out)
+{
+    if (len < WORDLE_MIN_WORD_LEN || len > WORDLE_MAX_WORD_LEN) {
+        return false;
+    }
+    wordle_word_t packed = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (word[i] < 'A' || word[i] > 'Z') {
+            return false;
+        }
+        packed |= (wordle_word_t)(word[i] - 'A') << (5 * i);
+    }
+    *out = packed;
+    return true;
+}
+
+wordle_in_type_t wordle_parse_inbound(char *buf, size_t len, wordle_in_msg_t *msg)
+{
+    scan_t s = { buf, buf + len };
+    wordle_in_type_t type = WORDLE_IN_MALFORMED;
+    bool have_type = false;
+    msg->name = NULL;
+    msg->word = NULL;
+    msg->bot = false;
+    msg->word_ok = false;
+
+    skip_ws(&s);
+    if (s.p == s.end || *s.p++ != '{') {
+        return WORDLE_IN_MALFORMED;
+    }
+    skip_ws(&s);
+    if (s.p < s.end && *s.p == '}') {
+        return WORDLE_IN_MALFORMED;   // {} has no type
+    }
+
+    for (;;) {
+        skip_ws(&s);
+        if (s.p == s.end || *s.p++ != '"') {
+            return WORDLE_IN_MALFORMED;
+        }
+        size_t key_len;
+        const char *key = read_string(&s, &key_len);
+        if (key == NULL) {
+            return WORDLE_IN_MALFORMED;
+        }
+        skip_ws(&s);
+        if (s.p == s.end || *s.p++ != ':') {
+            return WORDLE_IN_MALFORMED;
+        }
+        skip_ws(&s);
+        if (s.p == s.end) {
+            return WORDLE_IN_MALFORMED;
+        }
+
+        // The keys the server reads; everything else is stepped over
+        if (*s.p == '"' && key_len == 4) {
+            s.p++;
+            size_t value_len;
+            char *value = read_string(&s, &value_len);
+            if (value == NULL) {
+                return WORDLE_IN_MALFORMED;
+            }
+            if (memcmp(key, "type", 4) == 0) {
+                type = lookup_type(value, value_len);
+                have_type = true;
+            } else if (memcmp(key, "word", 4) == 0) {
+                msg->word = value;
+                msg->word_ok = pack_word(value, value_len, &msg->packed);
+                msg->word_len = (int)value_len;
+            } else if (memcmp(key, "name", 4) == 0) {
+                msg->name = value;
+            }
+            // Any other four-letter string key was read like a skipped value
+        } else if (key_len == 3 && memcmp(key, "bot", 3) == 0 && match_literal(&s, "true", 4)) {
+            msg->bot = true;
+        } else if (!skip_value(&s)) {
+            return WORDLE_IN_MALFORMED;
+        }
+
+        skip_ws(&s);
+        if (s.p == s.end) {
+            return WORDLE_IN_MALFORMED;
+        }
+        char c = *s.p++;
+        if (c == '}') {
+            break;
+        }
+        if (c != ',') {
+            return WORDLE_IN_MALFORMED;
+        }
+    }
+
+    if (!have_type) {
+        return WORDLE_IN_MALFORMED;
+    }
+    if ((type == WORDLE_IN_GUESS && msg->word == NULL) || (type == WORDLE_IN_JOIN && msg->name == NULL)) {
+        return WORDLE_IN_NONE;
+    }
+    return type;
+}
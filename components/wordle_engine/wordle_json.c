@@ -0,0 +1,181 @@
+#include "cJSON.h"
+#include "wordle_json.h"
+#include "wordle_pool.h"
+
+void wordle_json_use_pool(void)
+{
+    cJSON_Hooks hooks = {
+        .malloc_fn = wordle_pool_malloc,
+        .free_fn = wordle_pool_free,
+    };
+    cJSON_InitHooks(&hooks);
+}
+
+cJSON *wordle_msg_to_cjson(const wordle_msg_t *msg)
+{
+    cJSON *json = cJSON_CreateObject();
+    if (json == NULL) {
+        return NULL;
+    }
+
+    switch (msg->type) {
+    case WORDLE_MSG_WELCOME:
+        cJSON_AddStringToObject(json, "type", "welcome");
+        cJSON_AddNumberToObject(json, "player_index", msg->welcome.player_index);
+        cJSON_AddNumberToObject(json, "token", msg->welcome.token);
+        cJSON_AddBoolToObject(json, "resumed", msg->welcome.resumed);
+        cJSON_AddNumberToObject(json, "word_length", msg->variant->word_len);
+        cJSON_AddNumberToObject(json, "max_guesses", msg->variant->max_guesses);
+        break;
+
+    case WORDLE_MSG_LOBBY_UPDATE:
+        cJSON_AddStringToObject(json, "type", "lobby_update");
+        cJSON_AddNumberToObject(json, "player_count", msg->lobby_update.player_count);
+        break;
+
+    case WORDLE_MSG_GAME_STARTING:
+        cJSON_AddStringToObject(json, "type", "game_starting");
+        break;
+
+    case WORDLE_MSG_ROUND_START:
+        cJSON_AddStringToObject(json, "type", "round_start");
+        cJSON_AddNumberToObject(json, "round", msg->round_start.round);
+        cJSON_AddNumberToObject(json, "time_limit", msg->round_start.time_limit);
+
+        // Add hint for losing player (from NEW word)
+        if (msg->round_start.hint_player >= 0) {
+            cJSON_AddNumberToObject(json, "hint_player", msg->round_start.hint_player);
+            cJSON_AddNumberToObject(json, "hint_position", msg->round_start.hint_position);
+            cJSON_AddStringToObject(json, "hint_letter", (char[]){msg->round_start.hint_letter, '\0'});
+            cJSON_AddStringToObject(json, "hint_type", msg->round_start.hint_green ? "green" : "yellow");
+        }
+        break;
+
+    case WORDLE_MSG_RESULT: {
+        cJSON_AddStringToObject(json, "type", "result");
+        cJSON_AddStringToObject(json, "word", msg->result.word);
+        cJSON_AddNumberToObject(json, "player", msg->result.player);
+        int result[WORDLE_MAX_WORD_LEN];
+        msg->variant->fb_expand(msg->result.code, result);
+        cJSON_AddItemToObject(json, "result", cJSON_CreateIntArray(result, msg->variant->word_len));
+        cJSON_AddBoolToObject(json, "is_correct", msg->result.is_correct);
+        break;
+    }
+
+    case WORDLE_MSG_OPPONENT_SUBMITTED:
+        cJSON_AddStringToObject(json, "type", "opponent_submitted");
+        cJSON_AddNumberToObject(json, "opponent", msg->opponent_submitted.opponent);
+        cJSON_AddNumberToObject(json, "remaining", msg->opponent_submitted.remaining);
+        break;
+
+    case WORDLE_MSG_BOTH_GUESSED:
+        cJSON_AddStringToObject(json, "type", "both_guessed");
+        break;
+
+    case WORDLE_MSG_ROUND_END:
+        cJSON_AddStringToObject(json, "type", "round_end");
+        cJSON_AddNumberToObject(json, "winner", msg->round_end.winner);
+        cJSON_AddStringToObject(json, "target_word", msg->round_end.target_word);
+        cJSON_AddNumberToObject(json, "player1_score", msg->round_end.player1_score);
+        cJSON_AddNumberToObject(json, "player2_score", msg->round_end.player2_score);
+        break;
+
+    case WORDLE_MSG_TIMEOUT:
+        cJSON_AddStringToObject(json, "type", "timeout");
+        break;
+
+    case WORDLE_MSG_INVALID_GUESS:
+        cJSON_AddStringToObject(json, "type", "invalid_guess");
+        cJSON_AddStringToObject(json, "word", msg->invalid_guess.word);
+        break;
+    }
+
+    return json;
+}
+
+char *wordle_msg_to_json(const wordle_msg_t *msg)
+{
+    cJSON *json = wordle_msg_to_cjson(msg);
+    if (json == NULL) {
+        return NULL;
+    }
+    // Unformatted: cJSON_Print's indentation is pure overhead on the air
+    char *str = cJSON_PrintUnformatted(json);
+    cJSON_Delete(json);
+    return str;
+}
+
+char *wordle_msgs_to_json(const wordle_msg_t *msgs, int count)
+{
+    if (count == 1) {
+        return wordle_msg_to_json(&msgs[0]);
+    }
+
+    cJSON *array = cJSON_CreateArray();
+    if (array == NULL) {
+        return NULL;
+    }
+    for (int i = 0; i < count; i++) {
+        cJSON *item = wordle_msg_to_cjson(&msgs[i]);
+        if (item == NULL) {
+            cJSON_Delete(array);
+            return NULL;
+        }
+        cJSON_AddItemToArray(array, item);
+    }
+    char *str = cJSON_PrintUnformatted(array);
+    cJSON_Delete(array);
+    return str;
+}
+
+char *wordle_snapshot_to_json(const game_state_t *game, int viewer)
+{
+    cJSON *json = cJSON_CreateObject();
+    if (json == NULL) {
+        return NULL;
+    }
+    cJSON_AddStringToObject(json, "type", "snapshot");
+    cJSON_AddNumberToObject(json, "round", game->round_number);
+    cJSON_AddNumberToObject(json, "word_length", game->variant->word_len);
+    cJSON_AddNumberToObject(json, "max_guesses", game->variant->max_guesses);
+    int scores[WORDLE_MAX_PLAYERS] = { game->players[0].score, game->players[1].score };
+    cJSON_AddItemToObject(json, "scores", cJSON_CreateIntArray(scores, WORDLE_MAX_PLAYERS));
+    cJSON_AddBoolToObject(json, "active", game->game_active);
+    cJSON_AddBoolToObject(json, "round_over", game->round_over);
+    cJSON_AddNumberToObject(json, "hint_player", game->hint_player);
+    if (game->hint_player >= 0) {
+        cJSON_AddNumberToObject(json, "hint_position", game->hint.position);
+        cJSON_AddStringToObject(json, "hint_letter", (char[]){game->hint.letter, '\0'});
+        cJSON_AddStringToObject(json, "hint_type", game->hint.green ? "green" : "yellow");
+    }
+
+    cJSON *players = cJSON_AddArrayToObject(json, "players");
+    for (int i = 0; i < WORDLE_MAX_PLAYERS; i++) {
+        const player_t *player = &game->players[i];
+        cJSON *item = cJSON_CreateObject();
+        if (!cJSON_AddItemToArray(players, item)) {
+            cJSON_Delete(item);
+            break;
+        }
+        cJSON_AddNumberToObject(item, "guesses_used", player->guesses_used);
+        cJSON *rows = cJSON_AddArrayToObject(item, "rows");
+        int count = (viewer < 0 || viewer == i) ? player->row_count : 0;
+        for (int r = 0; r < count; r++) {
+            char word[WORDLE_MAX_WORD_LEN + 1];
+            int result[WORDLE_MAX_WORD_LEN];
+            game->variant->unpack(player->rows[r], word);
+            game->variant->fb_expand(player->codes[r], result);
+            cJSON *row = cJSON_CreateObject();
+            if (!cJSON_AddItemToArray(rows, row)) {
+                cJSON_Delete(row);
+                break;
+            }
+            cJSON_AddStringToObject(row, "word", word);
+            cJSON_AddItemToObject(row, "result", cJSON_CreateIntArray(result, game->variant->word_len));
+        }
+    }
+
+    char *str = cJSON_PrintUnformatted(json);
+    cJSON_Delete(json);
+    return str;
+}
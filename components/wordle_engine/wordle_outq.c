@@ -0,0 +1,52 @@
+#include <string.h>
+#include "wordle_outq.h"
+
+#ifdef ESP_PLATFORM
+#include "freertos/FreeRTOS.h"
+static portMUX_TYPE outq_lock = portMUX_INITIALIZER_UNLOCKED;
+#define OUTQ_LOCK()   portENTER_CRITICAL(&outq_lock)
+#define OUTQ_UNLOCK() portEXIT_CRITICAL(&outq_lock)
+#else
+// Host builds are single threaded
+#define OUTQ_LOCK()
+#define OUTQ_UNLOCK()
+#endif
+
+_Static_assert((WORDLE_OUTQ_LEN & (WORDLE_OUTQ_LEN - 1)) == 0, "queue length must be a power of two");
+
+void wordle_outq_reset(wordle_outq_t *q, int fd)
+{
+    OUTQ_LOCK();
+    q->fd = fd;
+    q->head = 0;
+    q->tail = 0;
+    q->dropped = 0;
+    OUTQ_UNLOCK();
+}
+
+bool wordle_outq_push(wordle_outq_t *q, const wordle_msg_t *msg)
+{
+    OUTQ_LOCK();
+    if ((uint16_t)(q->tail - q->head) == WORDLE_OUTQ_LEN) {
+        q->dropped++;
+        OUTQ_UNLOCK();
+        return false;
+    }
+    q->msgs[q->tail % WORDLE_OUTQ_LEN] = *msg;
+    q->tail++;
+    OUTQ_UNLOCK();
+    return true;
+}
+
+int wordle_outq_pop(wordle_outq_t *q, wordle_msg_t *out, int max, int *fd)
+{
+    OUTQ_LOCK();
+    int count = 0;
+    while (count < max && q->head != q->tail) {
+        out[count++] = q->msgs[q->head % WORDLE_OUTQ_LEN];
+        q->head++;
+    }
+    *fd = q->fd;
+    OUTQ_UNLOCK();
+    return count;
+}
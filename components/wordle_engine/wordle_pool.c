@@ -0,0 +1,124 @@
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "wordle_pool.h"
+
+#ifdef ESP_PLATFORM
+#include "freertos/FreeRTOS.h"
+static portMUX_TYPE pool_lock = portMUX_INITIALIZER_UNLOCKED;
+#define POOL_LOCK()   portENTER_CRITICAL(&pool_lock)
+#define POOL_UNLOCK() portEXIT_CRITICAL(&pool_lock)
+#else
+// Host builds are single threaded
+#define POOL_LOCK()
+#define POOL_UNLOCK()
+#endif
+
+typedef union block {
+    union block *next;       // Link while the block is free
+    uint64_t align;
+} block_t;
+
+typedef struct {
+    uint8_t *start;
+    uint8_t *end;
+    block_t *free_list;
+    wordle_pool_class_stats_t stats;
+} pool_class_t;
+
+static uint64_t arena_16[WORDLE_POOL_BLOCKS_16 * 16 / 8];
+static uint64_t arena_32[WORDLE_POOL_BLOCKS_32 * 32 / 8];
+static uint64_t arena_64[WORDLE_POOL_BLOCKS_64 * 64 / 8];
+static uint64_t arena_128[WORDLE_POOL_BLOCKS_128 * 128 / 8];
+static uint64_t arena_256[WORDLE_POOL_BLOCKS_256 * 256 / 8];
+
+#define CLASS(size, arena) \
+    { (uint8_t *)arena, (uint8_t *)arena + sizeof(arena), NULL, \
+      { size, sizeof(arena) / size, 0, 0, 0 } }
+
+static pool_class_t classes[WORDLE_POOL_CLASSES] = {
+    CLASS(16, arena_16),
+    CLASS(32, arena_32),
+    CLASS(64, arena_64),
+    CLASS(128, arena_128),
+    CLASS(256, arena_256),
+};
+
+static uint32_t fallbacks;
+static uint32_t fallback_max;
+static bool initialized;
+
+// Thread every block onto its class's free list, on first use so no init call
+// is needed before cJSON_InitHooks
+static void pool_init(void)
+{
+    for (int c = 0; c < WORDLE_POOL_CLASSES; c++) {
+        pool_class_t *pc = &classes[c];
+        for (uint8_t *p = pc->start; p < pc->end; p += pc->stats.block_size) {
+            block_t *b = (block_t *)p;
+            b->next = pc->free_list;
+            pc->free_list = b;
+        }
+    }
+    initialized = true;
+}
+
+void *wordle_pool_malloc(size_t size)
+{
+    POOL_LOCK();
+    if (!initialized) {
+        pool_init();
+    }
+    for (int c = 0; c < WORDLE_POOL_CLASSES; c++) {
+        pool_class_t *pc = &classes[c];
+        if (size > pc->stats.block_size || pc->free_list == NULL) {
+            continue;
+        }
+        block_t *b = pc->free_list;
+        pc->free_list = b->next;
+        pc->stats.allocs++;
+        if (++pc->stats.in_use > pc->stats.high_water) {
+            pc->stats.high_water = pc->stats.in_use;
+        }
+        POOL_UNLOCK();
+        return b;
+    }
+    fallbacks++;
+    if (size > fallback_max) {
+        fallback_max = size;
+    }
+    POOL_UNLOCK();
+    return malloc(size);
+}
+
+void wordle_pool_free(void *ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+    POOL_LOCK();
+    for (int c = 0; c < WORDLE_POOL_CLASSES; c++) {
+        pool_class_t *pc = &classes[c];
+        if ((uint8_t *)ptr >= pc->start && (uint8_t *)ptr < pc->end) {
+            block_t *b = ptr;
+            b->next = pc->free_list;
+            pc->free_list = b;
+            pc->stats.in_use--;
+            POOL_UNLOCK();
+            return;
+        }
+    }
+    POOL_UNLOCK();
+    free(ptr);
+}
+
+void wordle_pool_get_stats(wordle_pool_stats_t *stats)
+{
+    POOL_LOCK();
+    for (int c = 0; c < WORDLE_POOL_CLASSES; c++) {
+        stats->classes[c] = classes[c].stats;
+    }
+    stats->fallbacks = fallbacks;
+    stats->fallback_max = fallback_max;
+    POOL_UNLOCK();
+}
@@ -0,0 +1,152 @@
+#include <string.h>
+#include "wordle_proto.h"
+
+static uint8_t *put_u16(uint8_t *p, unsigned v)
+{
+    p[0] = v & 0xFF;
+    p[1] = (v >> 8) & 0xFF;
+    return p + 2;
+}
+
+static uint8_t *put_u32(uint8_t *p, uint32_t v)
+{
+    p = put_u16(p, v & 0xFFFF);
+    return put_u16(p, v >> 16);
+}
+
+static uint8_t *put_word(uint8_t *p, wordle_word_t word, int word_len)
+{
+    for (int i = 0; i < WORDLE_BIN_WORD_BYTES(word_len); i++) {
+        *p++ = (uint8_t)(word >> (8 * i));
+    }
+    return p;
+}
+
+static uint8_t *put_code(uint8_t *p, wordle_fb_t code, int word_len)
+{
+    if (WORDLE_BIN_CODE_BYTES(word_len) == 1) {
+        *p++ = (uint8_t)code;
+        return p;
+    }
+    return put_u16(p, code);
+}
+
+_Static_assert(WORDLE_BIN_SNAPSHOT_MAX - 2 <= UINT8_MAX, "snapshot length is one byte");
+
+size_t wordle_msg_to_binary(const wordle_msg_t *msg, uint8_t *out)
+{
+    const wordle_variant_t *v = msg->variant;
+    uint8_t *p = out;
+
+    switch (msg->type) {
+    case WORDLE_MSG_WELCOME:
+        *p++ = WORDLE_BIN_WELCOME;
+        *p++ = (uint8_t)msg->welcome.player_index;
+        p = put_u32(p, msg->welcome.token);
+        *p++ = msg->welcome.resumed;
+        *p++ = (uint8_t)v->word_len;
+        *p++ = (uint8_t)v->max_guesses;
+        break;
+
+    case WORDLE_MSG_LOBBY_UPDATE:
+        *p++ = WORDLE_BIN_LOBBY_UPDATE;
+        *p++ = (uint8_t)msg->lobby_update.player_count;
+        break;
+
+    case WORDLE_MSG_GAME_STARTING:
+        *p++ = WORDLE_BIN_GAME_STARTING;
+        break;
+
+    case WORDLE_MSG_ROUND_START:
+        *p++ = WORDLE_BIN_ROUND_START;
+        p = put_u16(p, msg->round_start.round);
+        *p++ = (uint8_t)msg->round_start.time_limit;
+        *p++ = (uint8_t)msg->round_start.hint_player;  // -1 -> 0xFF
+        *p++ = (uint8_t)msg->round_start.hint_position;
+        *p++ = (uint8_t)msg->round_start.hint_letter;
+        *p++ = msg->round_start.hint_green;
+        break;
+
+    case WORDLE_MSG_RESULT:
+        *p++ = WORDLE_BIN_RESULT;
+        *p++ = (uint8_t)msg->result.player;
+        p = put_code(p, msg->result.code, v->word_len);
+        p = put_word(p, msg->result.packed, v->word_len);
+        break;
+
+    case WORDLE_MSG_OPPONENT_SUBMITTED:
+        *p++ = WORDLE_BIN_OPPONENT_SUBMITTED;
+        *p++ = (uint8_t)msg->opponent_submitted.opponent;
+        p = put_u16(p, msg->opponent_submitted.remaining);
+        break;
+
+    case WORDLE_MSG_BOTH_GUESSED:
+        *p++ = WORDLE_BIN_BOTH_GUESSED;
+        break;
+
+    case WORDLE_MSG_ROUND_END: {
+        wordle_word_t target = 0;
+        v->pack(msg->round_end.target_word, &target);
+        *p++ = WORDLE_BIN_ROUND_END;
+        *p++ = (uint8_t)msg->round_end.winner;
+        p = put_u16(p, msg->round_end.player1_score);
+        p = put_u16(p, msg->round_end.player2_score);
+        p = put_word(p, target, v->word_len);
+        break;
+    }
+
+    case WORDLE_MSG_TIMEOUT:
+        *p++ = WORDLE_BIN_TIMEOUT;
+        break;
+
+    case WORDLE_MSG_INVALID_GUESS:
+        *p++ = WORDLE_BIN_INVALID_GUESS;
+        memset(p, 0, v->word_len);   // NUL padded when shorter
+        memcpy(p, msg->invalid_guess.word, strnlen(msg->invalid_guess.word, v->word_len));
+        p += v->word_len;
+        break;
+    }
+
+    return p - out;
+}
+
+size_t wordle_msgs_to_binary(const wordle_msg_t *msgs, int count, uint8_t *out)
+{
+    size_t len = 0;
+    for (int i = 0; i < count; i++) {
+        len += wordle_msg_to_binary(&msgs[i], out + len);
+    }
+    return len;
+}
+
+size_t wordle_snapshot_to_binary(const game_state_t *game, int viewer, uint8_t *out)
+{
+    const wordle_variant_t *v = game->variant;
+    uint8_t *p = out;
+    *p++ = WORDLE_BIN_SNAPSHOT;
+    p++;  // Length, filled in below
+    p = put_u16(p, game->round_number);
+    p = put_u16(p, game->players[0].score);
+    p = put_u16(p, game->players[1].score);
+    *p++ = game->game_active | game->round_over << 1;
+    *p++ = (uint8_t)game->hint_player;
+    *p++ = (uint8_t)game->hint.position;
+    *p++ = (uint8_t)game->hint.letter;
+    *p++ = game->hint.green;
+    *p++ = (uint8_t)v->word_len;
+    *p++ = (uint8_t)v->max_guesses;
+
+    for (int i = 0; i < WORDLE_MAX_PLAYERS; i++) {
+        const player_t *player = &game->players[i];
+        int rows = (viewer < 0 || viewer == i) ? player->row_count : 0;
+        *p++ = (uint8_t)player->guesses_used;
+        *p++ = (uint8_t)rows;
+        for (int r = 0; r < rows; r++) {
+            p = put_code(p, player->codes[r], v->word_len);
+            p = put_word(p, player->rows[r], v->word_len);
+        }
+    }
+
+    out[1] = (uint8_t)(p - out - 2);
+    return p - out;
+}
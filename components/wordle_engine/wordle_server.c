@@ -0,0 +1,207 @@
+#include <string.h>
+#include "esp_log.h"
+#include "esp_random.h"
+#include "wordle_server.h"
+#include "wordle_trace.h"
+
+static const char *TAG = "wordle server";
+
+void wordle_server_init(wordle_server_t *server, int fd_base, wordle_send_fn send, void *send_ctx)
+{
+    server->fd_base = fd_base;
+    server->rooms_in_use = 0;
+    memset(server->fd_index, 0xFF, sizeof(server->fd_index));
+    for (int v = 0; v < WORDLE_VARIANT_COUNT; v++) {
+        wordle_variants[v]->deck_init(&server->decks[v], esp_random());
+    }
+    for (int r = 0; r < WORDLE_MAX_ROOMS; r++) {
+        wordle_game_init(&server->rooms[r], send, send_ctx);
+        wordle_game_set_variant(&server->rooms[r], WORDLE_DEFAULT_VARIANT,
+                                &server->decks[WORDLE_DEFAULT_VARIANT_INDEX]);
+    }
+}
+
+void wordle_server_set_deadline(wordle_server_t *server, wordle_deadline_fn deadline, void *ctx)
+{
+    for (int r = 0; r < WORDLE_MAX_ROOMS; r++) {
+        wordle_game_set_deadline(&server->rooms[r], deadline, ctx);
+    }
+}
+
+static int pick_room(const wordle_server_t *server, const wordle_variant_t *variant)
+{
+    int empty = -1;
+    for (int r = 0; r < WORDLE_MAX_ROOMS; r++) {
+        const game_state_t *room = &server->rooms[r];
+        if (room->player_count == 1 && !room->game_active && room->variant == variant) {
+            return r;  // Someone is waiting for an opponent at this length
+        }
+        if (room->player_count == 0 && empty < 0) {
+            empty = r;
+        }
+    }
+    return empty;
+}
+
+// Room r for a connection playing variant; an empty room takes its length
+static game_state_t *open_room(wordle_server_t *server, int r, const wordle_variant_t *variant)
+{
+    game_state_t *room = &server->rooms[r];
+    if (room->player_count == 0) {
+        server->rooms_in_use++;
+        wordle_game_set_variant(room, variant, &server->decks[variant->index]);
+    }
+    return room;
+}
+
+// Never 0, which marks a seat without a token
+static uint32_t new_token(void)
+{
+    return esp_random() | 1;
+}
+
+game_state_t *wordle_server_connect(wordle_server_t *server, int fd, const wordle_variant_t *variant, int *slot)
+{
+    unsigned index = (unsigned)(fd - server->fd_base);
+    if (index >= WORDLE_MAX_FDS) {
+        ESP_LOGE(TAG, "fd %d outside the fd index (base %d, size %d)", fd, server->fd_base, WORDLE_MAX_FDS);
+        return NULL;
+    }
+
+    if (variant == NULL) {
+        variant = WORDLE_DEFAULT_VARIANT;
+    }
+    int r = pick_room(server, variant);
+    if (r < 0) {
+        return NULL;  // Every room is busy
+    }
+
+    game_state_t *room = open_room(server, r, variant);
+    *slot = wordle_add_player(room, fd);
+    room->players[*slot].token = new_token();
+    server->fd_index[index] = (uint16_t)(r << 1 | *slot);
+    WORDLE_TRACE(WORDLE_TRACE_FRAME, WORDLE_EV_WS_OPEN, fd, r, *slot);
+    return room;
+}
+
+game_state_t *wordle_server_resume(wordle_server_t *server, int fd, uint32_t token, int *slot)
+{
+    unsigned index = (unsigned)(fd - server->fd_base);
+    if (token == 0 || index >= WORDLE_MAX_FDS) {
+        return NULL;
+    }
+
+    // Rare enough (a reload, a phone waking up) that a scan is fine
+    for (int r = 0; r < WORDLE_MAX_ROOMS; r++) {
+        game_state_t *room = &server->rooms[r];
+        if (room->player_count == 0) {
+            continue;
+        }
+        for (int i = 0; i < WORDLE_MAX_PLAYERS; i++) {
+            player_t *player = &room->players[i];
+            if (player->connected && player->away && player->token == token) {
+                player->fd = fd;
+                player->away = false;
+                player->token = new_token();
+                server->fd_index[index] = (uint16_t)(r << 1 | i);
+                *slot = i;
+                ESP_LOGI(TAG, "Player %d back in room %d", i + 1, r);
+                WORDLE_TRACE(WORDLE_TRACE_FRAME, WORDLE_EV_WS_OPEN, fd, r, i);
+                return room;
+            }
+        }
+    }
+    return NULL;
+}
+
+// Seat the connection in room's slot elsewhere, as if it had just connected,
+// keeping its token and word length. False when no other room has a place for it.
+static bool move_player(wordle_server_t *server, game_state_t *room, int slot)
+{
+    int r = pick_room(server, room->variant);  // Not room: both its seats are taken
+    if (r < 0) {
+        return false;
+    }
+    game_state_t *dest = open_room(server, r, room->variant);
+    int fd = room->players[slot].fd;
+    int to = wordle_add_player(dest, fd);
+    dest->players[to].token = room->players[slot].token;
+    wordle_remove_slot(room, slot);
+    server->fd_index[fd - server->fd_base] = (uint16_t)(r << 1 | to);
+    ESP_LOGI(TAG, "fd %d moved to room %d to make way for the bot", fd, r);
+    WORDLE_TRACE(WORDLE_TRACE_FRAME, WORDLE_EV_WS_OPEN, fd, r, to);
+    return true;
+}
+
+bool wordle_server_add_bot(wordle_server_t *server, game_state_t *room, int slot, int *moved)
+{
+    int r = room - server->rooms;
+    *moved = -1;
+    if (room->game_active) {
+        return false;
+    }
+    if (room->player_count == WORDLE_MAX_PLAYERS) {
+        // Only a connection that has not joined yet makes way
+        int other = 1 - slot;
+        const player_t *idle = &room->players[other];
+        int fd = idle->fd;
+        if (idle->away || idle->name[0] != '\0' || !move_player(server, room, other)) {
+            return false;
+        }
+        *moved = fd;
+    }
+    if (room->player_count != 1) {
+        return false;
+    }
+    int bot = wordle_add_player(room, WORDLE_BOT_FD(r));
+    strcpy(room->players[bot].name, "Bot");
+    WORDLE_TRACE(WORDLE_TRACE_FRAME, WORDLE_EV_WS_OPEN, WORDLE_BOT_FD(r), r, bot);
+    return true;
+}
+
+// Free a seat, and the bot's with the last human
+static void leave(wordle_server_t *server, game_state_t *room, int slot)
+{
+    wordle_remove_slot(room, slot);
+    int bot = wordle_find_player(room, WORDLE_BOT_FD(room - server->rooms));
+    bool humans = false;
+    for (int i = 0; i < WORDLE_MAX_PLAYERS; i++) {
+        humans |= room->players[i].connected && i != bot;
+    }
+    if (bot >= 0 && !humans) {
+        wordle_remove_slot(room, bot);
+    }
+
+    if (room->player_count == 0) {
+        // Last one out: clear scores and round state for the next pair
+        wordle_game_reset(room);
+        server->rooms_in_use--;
+    }
+}
+
+bool wordle_server_disconnect(wordle_server_t *server, int fd, bool hold)
+{
+    int slot;
+    game_state_t *room = wordle_server_lookup(server, fd, &slot);
+    if (room == NULL) {
+        return false;
+    }
+    server->fd_index[fd - server->fd_base] = WORDLE_FD_UNUSED;
+
+    if (hold && room->game_active) {
+        room->players[slot].away = true;
+        ESP_LOGI(TAG, "Player %d dropped, holding the seat", slot + 1);
+        return true;
+    }
+    leave(server, room, slot);
+    return false;
+}
+
+void wordle_server_release(wordle_server_t *server, game_state_t *room, int slot, uint32_t token)
+{
+    player_t *player = &room->players[slot];
+    if (player->connected && player->away && player->token == token) {
+        ESP_LOGI(TAG, "Player %d did not come back, freeing the seat", slot + 1);
+        leave(server, room, slot);
+    }
+}
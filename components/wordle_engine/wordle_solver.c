@@ -0,0 +1,88 @@
+#include <math.h>
+#include <stdbool.h>
+#include <string.h>
+#include "wordle_solver.h"
+#include "wordle_fb_matrix.h"
+
+// Opening guess, the same for every game; -1 until first needed
+static int opening_guess = -1;
+
+void wordle_solver_reset(wordle_solver_t *solver)
+{
+    for (uint16_t i = 0; i < WORDLE_ANSWER_COUNT; i++) {
+        solver->candidates[i] = i;
+    }
+    solver->count = WORDLE_ANSWER_COUNT;
+}
+
+void wordle_solver_filter(wordle_solver_t *solver, uint16_t guess_index, wordle_fb_t code)
+{
+    uint16_t kept = 0;
+    for (uint16_t i = 0; i < solver->count; i++) {
+        uint16_t answer = solver->candidates[i];
+        if (wordle_fb_lookup(guess_index, answer) == code) {
+            solver->candidates[kept++] = answer;
+        }
+    }
+    solver->count = kept;
+}
+
+// Sum of c * log2(c) over the feedback buckets of one guess. Entropy is
+// log2(n) - this / n, so the best guess is the one with the smallest sum.
+// The buckets are static: at seven letters they are 8 KB, more than the bot
+// task's stack, and only that task runs the solver.
+static float bucket_cost(const wordle_solver_t *solver, uint16_t guess)
+{
+    static uint16_t buckets[WORDLE_FB_CODES];
+    static wordle_fb_t used[WORDLE_FB_CODES];
+    int used_count = 0;
+
+    memset(buckets, 0, sizeof(buckets));
+    for (uint16_t i = 0; i < solver->count; i++) {
+        wordle_fb_t code = wordle_fb_lookup(guess, solver->candidates[i]);
+        if (buckets[code]++ == 0) {
+            used[used_count++] = code;
+        }
+    }
+
+    float cost = 0.0f;
+    for (int i = 0; i < used_count; i++) {
+        float c = buckets[used[i]];
+        cost += c * log2f(c);
+    }
+    return cost;
+}
+
+uint16_t wordle_solver_best_guess(const wordle_solver_t *solver)
+{
+    if (solver->count <= 2) {
+        return solver->count ? solver->candidates[0] : 0;  // Nothing left to split
+    }
+    bool opening = solver->count == WORDLE_ANSWER_COUNT;
+    if (opening && opening_guess >= 0) {
+        return (uint16_t)opening_guess;
+    }
+
+    uint8_t is_candidate[(WORDLE_ANSWER_COUNT + 7) / 8] = {0};
+    for (uint16_t i = 0; i < solver->count; i++) {
+        is_candidate[solver->candidates[i] >> 3] |= 1u << (solver->candidates[i] & 7);
+    }
+
+    uint16_t best = solver->candidates[0];
+    float best_cost = INFINITY;
+    bool best_is_candidate = true;
+    for (uint16_t g = 0; g < WORDLE_ANSWER_COUNT; g++) {
+        float cost = bucket_cost(solver, g);
+        bool candidate = is_candidate[g >> 3] & (1u << (g & 7));
+        if (cost < best_cost - 1e-3f || (cost < best_cost + 1e-3f && candidate && !best_is_candidate)) {
+            best = g;
+            best_cost = cost;
+            best_is_candidate = candidate;
+        }
+    }
+
+    if (opening) {
+        opening_guess = best;
+    }
+    return best;
+}
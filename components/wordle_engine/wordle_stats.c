@@ -0,0 +1,136 @@
+#include <string.h>
+#include "wordle_stats.h"
+
+void wordle_stats_init(wordle_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+}
+
+// Slot for name, taking a free or evicted one for a new player. Entries
+// already recorded in this round are never evicted: the other player's fresh
+// one has the fewest rounds and would otherwise go first. -1 when the name is
+// empty or nothing can be evicted.
+static int find_entry(wordle_stats_t *stats, const char *name)
+{
+    char key[WORDLE_STATS_NAME_LEN];
+    strncpy(key, name, sizeof(key) - 1);
+    key[sizeof(key) - 1] = '\0';
+    if (key[0] == '\0') {
+        return -1;
+    }
+
+    int victim = -1;
+    for (int i = 0; i < WORDLE_STATS_PLAYERS; i++) {
+        const wordle_stats_entry_t *e = &stats->entries[i];
+        if (strcmp(e->name, key) == 0) {
+            return i;
+        }
+        const wordle_stats_entry_t *v = victim >= 0 ? &stats->entries[victim] : NULL;
+        if (v != NULL && v->name[0] == '\0') {
+            continue;  // Already have a free slot
+        }
+        if (e->name[0] != '\0' && e->played > 0 && e->last_round == stats->rounds) {
+            continue;  // Recorded this round
+        }
+        if (v == NULL || e->name[0] == '\0' || e->played < v->played ||
+            (e->played == v->played && e->last_round < v->last_round)) {
+            victim = i;
+        }
+    }
+    if (victim < 0) {
+        return -1;
+    }
+
+    wordle_stats_entry_t *e = &stats->entries[victim];
+    memset(e, 0, sizeof(*e));
+    strcpy(e->name, key);
+    return victim;
+}
+
+void wordle_stats_record(wordle_stats_t *stats, const game_state_t *game, int winner)
+{
+    wordle_stats_round_t *round = &stats->history[stats->rounds % WORDLE_STATS_HISTORY];
+    memset(round, 0, sizeof(*round));
+    round->winner = (int8_t)winner;
+    round->target = game->target_packed;
+    round->word_len = (uint8_t)game->variant->word_len;
+
+    for (int p = 0; p < WORDLE_MAX_PLAYERS; p++) {
+        const player_t *player = &game->players[p];
+        strncpy(round->names[p], player->name, WORDLE_STATS_NAME_LEN - 1);
+        round->guesses[p] = (uint8_t)player->guesses_used;
+        round->solved |= player->has_won << p;
+
+        int i = find_entry(stats, player->name);
+        if (i < 0) {
+            continue;
+        }
+        wordle_stats_entry_t *e = &stats->entries[i];
+        e->played++;
+        e->wins += (winner == p);
+        if (player->has_won && player->guesses_used >= 1 && player->guesses_used <= WORDLE_MAX_ROWS) {
+            e->solved[player->guesses_used - 1]++;
+        }
+        e->last_round = stats->rounds;
+        stats->dirty |= 1u << i;
+    }
+
+    stats->rounds++;
+    stats->history_dirty = true;
+}
+
+// Total guesses over solves, and the solve count
+static void solve_totals(const wordle_stats_entry_t *e, unsigned *guesses, unsigned *solves)
+{
+    *guesses = 0;
+    *solves = 0;
+    for (int g = 0; g < WORDLE_MAX_ROWS; g++) {
+        *guesses += e->solved[g] * (g + 1);
+        *solves += e->solved[g];
+    }
+}
+
+// True when a ranks above b
+static bool ranks_above(const wordle_stats_entry_t *a, const wordle_stats_entry_t *b)
+{
+    if (a->wins != b->wins) {
+        return a->wins > b->wins;
+    }
+    unsigned ag, as, bg, bs;
+    solve_totals(a, &ag, &as);
+    solve_totals(b, &bg, &bs);
+    // Fewer guesses per solve, compared without dividing; no solves ranks last
+    if (as && bs && ag * bs != bg * as) {
+        return ag * bs < bg * as;
+    }
+    if ((as == 0) != (bs == 0)) {
+        return as != 0;
+    }
+    return a->played > b->played;
+}
+
+int wordle_stats_rank(const wordle_stats_t *stats, uint8_t *order, int max)
+{
+    // Insertion sort, the table is a few dozen entries
+    int count = 0;
+    for (int i = 0; i < WORDLE_STATS_PLAYERS; i++) {
+        const wordle_stats_entry_t *e = &stats->entries[i];
+        if (e->name[0] == '\0') {
+            continue;
+        }
+        int pos = count < max ? count : max;
+        while (pos > 0 && ranks_above(e, &stats->entries[order[pos - 1]])) {
+            pos--;
+        }
+        if (pos >= max) {
+            continue;
+        }
+        int end = count < max ? count : max - 1;
+        memmove(&order[pos + 1], &order[pos], (size_t)(end - pos));
+        order[pos] = (uint8_t)i;
+        if (count < max) {
+            count++;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,109 @@
+#include <stdatomic.h>
+#include <stdio.h>
+#include "wordle_trace.h"
+#include "wordle_engine.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_timer.h"
+#define trace_now_us() ((uint32_t)esp_timer_get_time())
+#else
+#include <time.h>
+static uint32_t trace_now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000000ull + ts.tv_nsec / 1000);
+}
+#endif
+
+_Static_assert((WORDLE_TRACE_LEN & (WORDLE_TRACE_LEN - 1)) == 0, "trace length must be a power of two");
+
+// Nothing is ever written with tracing compiled out, keep the ring token-sized
+#define RING_LEN (WORDLE_TRACE_LEVEL > 0 ? WORDLE_TRACE_LEN : 1)
+
+static wordle_trace_entry_t ring[RING_LEN];
+static atomic_uint_fast32_t head;
+
+void wordle_trace_write(wordle_trace_event_t event, int fd, int32_t a, int32_t b)
+{
+    uint32_t seq = atomic_fetch_add_explicit(&head, 1, memory_order_relaxed);
+    wordle_trace_entry_t *e = &ring[seq % RING_LEN];
+    e->time_us = trace_now_us();
+    e->event = event;
+    e->fd = fd;
+    e->a = a;
+    e->b = b;
+}
+
+uint32_t wordle_trace_head(void)
+{
+    return atomic_load_explicit(&head, memory_order_acquire);
+}
+
+void wordle_trace_read(uint32_t seq, wordle_trace_entry_t *out)
+{
+    *out = ring[seq % RING_LEN];
+}
+
+int wordle_trace_format(const wordle_trace_entry_t *e, char *buf, size_t len)
+{
+    int n = snprintf(buf, len, "%10lu fd %3d ", (unsigned long)e->time_us, e->fd);
+    if (n < 0 || (size_t)n >= len) {
+        return n;
+    }
+    buf += n;
+    len -= n;
+
+    char word[WORDLE_MAX_WORD_LEN + 1];
+    const wordle_variant_t *v;
+    switch (e->event) {
+    case WORDLE_EV_WS_OPEN:
+        return n + snprintf(buf, len, "ws open, room %ld slot %ld\n", (long)e->a, (long)e->b);
+    case WORDLE_EV_WS_RX:
+        return n + snprintf(buf, len, "rx %ld bytes\n", (long)e->a);
+    case WORDLE_EV_WS_TX:
+        return n + snprintf(buf, len, "tx %ld messages, %ld bytes\n", (long)e->a, (long)e->b);
+    case WORDLE_EV_ROUND_START:
+        v = wordle_variant_get(e->a >> 24);
+        if (v == NULL || e->b < 0 || e->b >= v->answer_count) {
+            return n + snprintf(buf, len, "round %ld start, target %ld\n", (long)(e->a & 0xFFFFFF), (long)e->b);
+        }
+        v->unpack(v->answers[e->b], word);
+        return n + snprintf(buf, len, "round %ld start, target %s\n", (long)(e->a & 0xFFFFFF), word);
+    case WORDLE_EV_HINT:
+        return n + snprintf(buf, len, "hint for player %ld: '%c' at %ld (%s)\n", (long)e->a + 1,
+                            (char)(e->b & 0xFF), (long)((e->b >> 8) & 0xFF),
+                            (e->b & 0x10000) ? "green" : "yellow");
+    case WORDLE_EV_GUESS: {
+        v = wordle_variant_get((uint32_t)e->a >> 28);
+        if (v == NULL) {
+            break;
+        }
+        int result[WORDLE_MAX_WORD_LEN];
+        char code[WORDLE_MAX_WORD_LEN + 1];
+        v->unpack((wordle_word_t)((uint64_t)((uint32_t)e->a >> 24 & 7) << 32 | (uint32_t)e->b), word);
+        v->fb_expand((wordle_fb_t)((e->a >> 8) & 0xFFFF), result);
+        for (int i = 0; i < v->word_len; i++) {
+            code[i] = (char)('0' + result[i]);
+        }
+        code[v->word_len] = '\0';
+        return n + snprintf(buf, len, "player %ld guessed %s %s\n", (long)(e->a & 0xFF) + 1, word, code);
+    }
+    case WORDLE_EV_GUESS_IGNORED:
+        return n + snprintf(buf, len, "player %ld guess ignored (%s)\n", (long)e->a + 1,
+                            e->b == 2 ? "no round yet" : e->b ? "round over or won" : "already submitted");
+    case WORDLE_EV_INVALID_GUESS:
+        return n + snprintf(buf, len, "player %ld guess not in word list\n", (long)e->a + 1);
+    case WORDLE_EV_TURN_DONE:
+        return n + snprintf(buf, len, "round %ld turn done, guesses %ld/%ld\n", (long)e->a,
+                            (long)(e->b >> 8), (long)(e->b & 0xFF));
+    case WORDLE_EV_TIMEOUT:
+        return n + snprintf(buf, len, "player %ld timed out\n", (long)e->a + 1);
+    case WORDLE_EV_ROUND_END:
+        return n + snprintf(buf, len, "round %ld end, winner %ld\n", (long)e->a,
+                            e->b < 0 ? 0L : (long)e->b + 1);
+    case WORDLE_EV_NEXT_ROUND:
+        return n + snprintf(buf, len, "next round %s\n", e->a ? "requested" : "refused, round not over");
+    }
+    return n + snprintf(buf, len, "event %u %ld %ld\n", e->event, (long)e->a, (long)e->b);
+}
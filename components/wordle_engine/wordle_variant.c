@@ -0,0 +1,30 @@
+#include "wordle_variant.h"
+#include "wordle_dict.h"
+
+const wordle_variant_t wordle_variant = {
+    .word_len = WORDLE_WORD_LEN,
+    .max_guesses = WORDLE_MAX_GUESSES,
+    .index = WORDLE_V(WORDLE_VARIANT_INDEX),
+    .answer_count = WORDLE_ANSWER_COUNT,
+    .all_green = WORDLE_FB_ALL_GREEN,
+    .answers = wordle_answers,
+
+    .pack = wordle_pack,
+    .unpack = wordle_unpack,
+    .fb_expand = wordle_fb_expand,
+    .feedback = wordle_feedback,
+    .dict_contains = wordle_dict_contains,
+
+    .cands_reset = wordle_cands_reset,
+    .cands_apply = wordle_cands_apply,
+    .cands_count = wordle_cands_count,
+    .hint_pick = wordle_hint_pick,
+
+    .solver_reset = wordle_solver_reset,
+    .solver_filter = wordle_solver_filter,
+    .solver_best_guess = wordle_solver_best_guess,
+
+    .deck_init = wordle_deck_init,
+    .deck_restore = wordle_deck_restore,
+    .deck_draw = wordle_deck_draw,
+};
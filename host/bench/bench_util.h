@@ -0,0 +1,27 @@
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+// Monotonic clock in nanoseconds
+static inline uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// Keeps the compiler from discarding results we only compute for timing
+static volatile uint64_t bench_sink;
+
+static inline void bench_report(const char *name, uint64_t ops, uint64_t elapsed_ns)
+{
+    double ns_per_op = ops ? (double)elapsed_ns / (double)ops : 0.0;
+    double ops_per_s = elapsed_ns ? (double)ops * 1e9 / (double)elapsed_ns : 0.0;
+    printf("%-36s %12llu ops %10.1f ns/op %14.0f ops/s %10.3f ms total\n",
+           name, (unsigned long long)ops, ns_per_op, ops_per_s, elapsed_ns / 1e6);
+}
+
+#endif // BENCH_UTIL_H
@@ -0,0 +1,94 @@
+// Block pool vs malloc for the allocation pattern of one JSON message:
+// a handful of tree nodes and short strings, a 256-byte print buffer and the
+// final exact-size copy, all released together. Also prints the pool's
+// high-water marks, which is what the block counts in wordle_pool.h are
+// sized from.
+#include <stdlib.h>
+#include <string.h>
+#include "wordle_engine.h"
+#include "wordle_pool.h"
+#ifdef WORDLE_HAVE_CJSON
+#include "wordle_json.h"
+#endif
+#include "bench_util.h"
+
+#define MESSAGES  1000000
+
+// A result message: object + 5 items (40-byte nodes on the ESP32), keys,
+// values, print buffer and final string
+static const size_t message_sizes[] = {
+    40, 40, 5, 40, 7, 6, 40, 7, 40, 7, 40, 11, 40, 40, 40, 40, 40, 256, 72,
+};
+#define MESSAGE_ALLOCS (sizeof(message_sizes) / sizeof(message_sizes[0]))
+
+static uint64_t run(void *(*alloc)(size_t), void (*release)(void *))
+{
+    void *live[MESSAGE_ALLOCS];
+    uint64_t start = bench_now_ns();
+    for (int m = 0; m < MESSAGES; m++) {
+        for (size_t i = 0; i < MESSAGE_ALLOCS; i++) {
+            live[i] = alloc(message_sizes[i]);
+            *(volatile char *)live[i] = (char)i;
+        }
+        for (size_t i = 0; i < MESSAGE_ALLOCS; i++) {
+            release(live[i]);
+        }
+    }
+    return bench_now_ns() - start;
+}
+
+#ifdef WORDLE_HAVE_CJSON
+// Serialize and re-parse a round's worth of messages, as the server and a
+// receiving client would
+static uint64_t run_cjson(int rounds)
+{
+    wordle_msg_t result = { .type = WORDLE_MSG_RESULT, .result = { "CRANE", 0, 1, 0, false } };
+    wordle_msg_t start_msg = { .type = WORDLE_MSG_ROUND_START,
+                               .round_start = { 3, WORDLE_TIME_LIMIT, 0, 2, 'A', false } };
+    uint64_t start = bench_now_ns();
+    for (int r = 0; r < rounds; r++) {
+        const wordle_msg_t *msgs[] = { &start_msg, &result, &result, &result };
+        for (size_t i = 0; i < 4; i++) {
+            char *s = wordle_msg_to_json(msgs[i]);
+            cJSON *tree = cJSON_Parse(s);
+            bench_sink += (uintptr_t)tree;
+            cJSON_Delete(tree);
+            cJSON_free(s);
+        }
+    }
+    return bench_now_ns() - start;
+}
+#endif
+
+static void print_stats(void)
+{
+    wordle_pool_stats_t stats;
+    wordle_pool_get_stats(&stats);
+    printf("\n%-8s %8s %8s %12s\n", "class", "blocks", "high", "allocs");
+    for (int c = 0; c < WORDLE_POOL_CLASSES; c++) {
+        const wordle_pool_class_stats_t *cs = &stats.classes[c];
+        printf("%5u B  %8u %8u %12lu\n", cs->block_size, cs->blocks, cs->high_water,
+               (unsigned long)cs->allocs);
+    }
+    printf("fallbacks %lu, largest %lu B\n", (unsigned long)stats.fallbacks,
+           (unsigned long)stats.fallback_max);
+}
+
+int main(void)
+{
+    uint64_t ops = (uint64_t)MESSAGES * MESSAGE_ALLOCS;
+    bench_report("malloc/free (message pattern)", ops, run(malloc, free));
+    bench_report("pool (message pattern)", ops, run(wordle_pool_malloc, wordle_pool_free));
+
+#ifdef WORDLE_HAVE_CJSON
+    const int rounds = 100000;
+    bench_report("cJSON round, heap", rounds, run_cjson(rounds));
+    wordle_json_use_pool();
+    bench_report("cJSON round, pool", rounds, run_cjson(rounds));
+#else
+    printf("(built without cJSON, cJSON rounds skipped)\n");
+#endif
+
+    print_stats();
+    return 0;
+}
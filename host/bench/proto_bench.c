@@ -0,0 +1,346 @@
+// Wire size and encode cost of the binary protocol against the JSON one.
+// "On air" is the WebSocket payload plus the 2-byte server frame header
+// (unmasked, payload < 126 bytes), which is what a softAP client receives.
+// Also the inbound side: the in-place frame parser against cJSON.
+#include <stdlib.h>
+#include <string.h>
+#include "wordle_engine.h"
+#include "wordle_proto.h"
+#include "wordle_frame.h"
+#include "wordle_outq.h"
+#include "wordle_inbound.h"
+#ifdef WORDLE_HAVE_CJSON
+#include "cJSON.h"
+#include "wordle_json.h"
+#endif
+#include "bench_util.h"
+
+#define ENCODE_REPEAT  200000
+#define WS_HEADER_LEN  2
+#define VIEWERS        4    // CONFIG_ESP_MAX_STA_CONN default
+#define MID_ROWS       (WORDLE_MAX_GUESSES < 4 ? WORDLE_MAX_GUESSES : 4)
+
+// Sample words of the build's length: a guess, the target, a non-word and
+// two boards of MID_ROWS guesses
+#if WORDLE_WORD_LEN == 4
+#define GUESS    "CARE"
+#define TARGET   "SHOE"
+#define NONWORD  "QZXJ"
+#define BOARDS   { { "CARE", "SLOT", "PUMP", "SHOP" }, { "AUNT", "CROW", "BLIP", "SHOT" } }
+#elif WORDLE_WORD_LEN == 5
+#define GUESS    "CRANE"
+#define TARGET   "SHAKE"
+#define NONWORD  "QZXJV"
+#define BOARDS   { { "CRANE", "SLOTH", "PUDGY", "SHAKE" }, { "AUDIO", "CRONY", "BLIMP", "SHAME" } }
+#elif WORDLE_WORD_LEN == 6
+#define GUESS    "CASTLE"
+#define TARGET   "SHRINK"
+#define NONWORD  "QZXJVW"
+#define BOARDS   { { "CASTLE", "BORDER", "PUZZLE", "SHRINK" }, { "ADVICE", "GROUND", "BLIGHT", "SHRINE" } }
+#else
+#define GUESS    "CRANKED"
+#define TARGET   "SHAKING"
+#define NONWORD  "QZXJVWK"
+#define BOARDS   { { "CRANKED", "SPLOTCH", "PUDGIER", "SHAKING" }, { "AUDIBLE", "CRONIES", "BLITZED", "SHAKERS" } }
+#endif
+
+// Sample messages of the build's length, as a room of that length sends them
+typedef struct {
+    const char *name;
+    wordle_msg_t msg;
+    int per_round;    // How often one player receives it in a typical 5-guess round
+} sample_t;
+
+static sample_t samples[] = {
+    { "welcome",            { .variant = &wordle_variant, .type = WORDLE_MSG_WELCOME, .welcome = { 1 } }, 0 },
+    { "lobby_update",       { .variant = &wordle_variant, .type = WORDLE_MSG_LOBBY_UPDATE, .lobby_update = { 2 } }, 0 },
+    { "game_starting",      { .variant = &wordle_variant, .type = WORDLE_MSG_GAME_STARTING }, 0 },
+    { "round_start",        { .variant = &wordle_variant, .type = WORDLE_MSG_ROUND_START,
+                              .round_start = { 12, WORDLE_TIME_LIMIT, 1, 3, 'K', true } }, 1 },
+    { "result",             { .variant = &wordle_variant, .type = WORDLE_MSG_RESULT,
+                              .result = { GUESS, 0, 1, 0, false } }, 5 },
+    { "opponent_submitted", { .variant = &wordle_variant, .type = WORDLE_MSG_OPPONENT_SUBMITTED, .opponent_submitted = { 0, 42 } }, 5 },
+    { "both_guessed",       { .variant = &wordle_variant, .type = WORDLE_MSG_BOTH_GUESSED }, 5 },
+    { "round_end",          { .variant = &wordle_variant, .type = WORDLE_MSG_ROUND_END,
+                              .round_end = { -1, TARGET, 7, 4 } }, 1 },
+    { "timeout",            { .variant = &wordle_variant, .type = WORDLE_MSG_TIMEOUT }, 0 },
+    { "invalid_guess",      { .variant = &wordle_variant, .type = WORDLE_MSG_INVALID_GUESS, .invalid_guess = { NONWORD } }, 0 },
+};
+
+#define SAMPLE_COUNT (sizeof(samples) / sizeof(samples[0]))
+
+// A room four guesses into round 3, as a late spectator would find it
+static void mid_round(game_state_t *game)
+{
+    static const char *boards[WORDLE_MAX_PLAYERS][4] = BOARDS;
+    wordle_game_init(game, NULL, NULL);
+    wordle_pack(TARGET, &game->target_packed);
+    game->game_active = true;
+    game->round_number = 3;
+    game->players[0].score = 2;
+    for (int i = 0; i < WORDLE_MAX_PLAYERS; i++) {
+        player_t *player = &game->players[i];
+        for (int r = 0; r < MID_ROWS; r++) {
+            wordle_pack(boards[i][r], &player->rows[r]);
+            player->codes[r] = wordle_feedback(player->rows[r], game->target_packed);
+        }
+        player->row_count = player->guesses_used = MID_ROWS;
+    }
+}
+
+// Fan-out of one result to every spectator: encoded per viewer, as the
+// player path does, against once into a frame the viewers share. The device
+// shares frames only with JSON viewers, where encoding is the larger cost.
+static void bench_spectators(void)
+{
+    game_state_t game;
+    mid_round(&game);
+    uint8_t snap[WORDLE_BIN_SNAPSHOT_MAX];
+    size_t bin = wordle_snapshot_to_binary(&game, -1, snap) + WS_HEADER_LEN;
+    size_t json = 0;
+#ifdef WORDLE_HAVE_CJSON
+    char *s = wordle_snapshot_to_json(&game, -1);
+    json = strlen(s) + WS_HEADER_LEN;
+    free(s);
+#endif
+    printf("\n%-14s %d+%d rows %8zu %8zu\n", "snapshot,", MID_ROWS, MID_ROWS, bin, json);
+
+    // Per viewer means what players get: the message through an outq, then
+    // encoded for that socket
+    const wordle_msg_t *msg = &samples[4].msg;
+    static wordle_frameq_t q[VIEWERS];
+    static wordle_outq_t outq[VIEWERS];
+    wordle_msg_t popped;
+    int fd;
+    uint8_t buf[WORDLE_BIN_MAX_LEN];
+    uint64_t start = bench_now_ns();
+    for (int r = 0; r < ENCODE_REPEAT; r++) {
+        wordle_frame_t *frame = wordle_frame_alloc(WORDLE_BIN_MAX_LEN, true);
+        frame->len = wordle_msg_to_binary(msg, frame->data);
+        for (int v = 0; v < VIEWERS; v++) {
+            wordle_frameq_push(&q[v], frame);
+        }
+        wordle_frame_unref(frame);
+        for (int v = 0; v < VIEWERS; v++) {
+            wordle_frame_t *out = wordle_frameq_pop(&q[v]);
+            bench_sink += out->len;
+            wordle_frame_unref(out);
+        }
+    }
+    bench_report("binary fan-out x4, shared frame", ENCODE_REPEAT, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (int r = 0; r < ENCODE_REPEAT; r++) {
+        for (int v = 0; v < VIEWERS; v++) {
+            wordle_outq_push(&outq[v], msg);
+            wordle_outq_pop(&outq[v], &popped, 1, &fd);
+            bench_sink += wordle_msg_to_binary(&popped, buf);
+        }
+    }
+    bench_report("binary fan-out x4, per viewer", ENCODE_REPEAT, bench_now_ns() - start);
+
+#ifdef WORDLE_HAVE_CJSON
+    start = bench_now_ns();
+    for (int r = 0; r < ENCODE_REPEAT; r++) {
+        char *str = wordle_msg_to_json(msg);
+        size_t len = strlen(str);
+        wordle_frame_t *frame = wordle_frame_alloc(len, false);
+        memcpy(frame->data, str, len);
+        free(str);
+        for (int v = 0; v < VIEWERS; v++) {
+            wordle_frameq_push(&q[v], frame);
+        }
+        wordle_frame_unref(frame);
+        for (int v = 0; v < VIEWERS; v++) {
+            wordle_frame_t *out = wordle_frameq_pop(&q[v]);
+            bench_sink += out->len;
+            wordle_frame_unref(out);
+        }
+    }
+    bench_report("json fan-out x4, shared frame", ENCODE_REPEAT, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (int r = 0; r < ENCODE_REPEAT; r++) {
+        for (int v = 0; v < VIEWERS; v++) {
+            wordle_outq_push(&outq[v], msg);
+            wordle_outq_pop(&outq[v], &popped, 1, &fd);
+            char *str = wordle_msg_to_json(&popped);
+            bench_sink += strlen(str);
+            free(str);
+        }
+    }
+    bench_report("json fan-out x4, per viewer", ENCODE_REPEAT, bench_now_ns() - start);
+#endif
+}
+
+typedef struct {
+    const char *text;
+    wordle_in_type_t type;
+    bool word_ok;
+} inbound_sample_t;
+
+// What script.js sends, then the edge cases the parser has to get right. The
+// parser packs every length the build has; longer than all of them is no word.
+static const inbound_sample_t inbound[] = {
+    { "{\"type\":\"guess\",\"word\":\"" GUESS "\"}", WORDLE_IN_GUESS, true },
+    { "{\"type\":\"join\",\"name\":\"Player One\",\"bot\":false}", WORDLE_IN_JOIN, false },
+    { "{\"type\":\"next_round\"}", WORDLE_IN_NEXT_ROUND, false },
+    { "{ \"word\" : \"crane\", \"type\" : \"guess\" }", WORDLE_IN_GUESS, false },
+    { "{\"type\":\"guess\",\"word\":\"CROSSWORD\"}", WORDLE_IN_GUESS, false },
+    { "{\"type\":\"join\",\"name\":\"\\\"Q\\\" \\u00e9\\ud83d\\ude00\",\"bot\":true}", WORDLE_IN_JOIN, false },
+    { "{\"v\":[1,{\"a\":\"}\"}],\"type\":\"ping\",\"n\":-1.5e3}", WORDLE_IN_NONE, false },
+    { "{\"type\":\"guess\"}", WORDLE_IN_NONE, false },
+    { "{\"word\":\"" GUESS "\"}", WORDLE_IN_MALFORMED, false },
+    { "{\"type\":\"guess\",\"word\":\"" GUESS "\"", WORDLE_IN_MALFORMED, false },
+    { "{\"type\":guess}", WORDLE_IN_MALFORMED, false },
+    { "[\"guess\"]", WORDLE_IN_MALFORMED, false },
+};
+
+#define INBOUND_COUNT (sizeof(inbound) / sizeof(inbound[0]))
+#define PARSE_REPEAT  1000000
+
+#ifdef WORDLE_HAVE_CJSON
+// What ws_handler did before the parser: a cJSON tree, then strcmp on the type
+static int cjson_decode(const char *text, size_t len, char *word, size_t word_len)
+{
+    cJSON *json = cJSON_ParseWithLength(text, len);
+    if (json == NULL) {
+        return -1;
+    }
+    int type = -1;
+    cJSON *type_item = cJSON_GetObjectItem(json, "type");
+    if (type_item != NULL && cJSON_IsString(type_item)) {
+        const char *msg_type = type_item->valuestring;
+        if (strcmp(msg_type, "guess") == 0) {
+            cJSON *word_item = cJSON_GetObjectItem(json, "word");
+            if (word_item != NULL && cJSON_IsString(word_item)) {
+                strncpy(word, word_item->valuestring, word_len - 1);
+                type = WORDLE_IN_GUESS;
+            }
+        } else if (strcmp(msg_type, "next_round") == 0) {
+            type = WORDLE_IN_NEXT_ROUND;
+        } else if (strcmp(msg_type, "join") == 0) {
+            cJSON *name_item = cJSON_GetObjectItem(json, "name");
+            if (name_item != NULL && cJSON_IsString(name_item)) {
+                strncpy(word, name_item->valuestring, word_len - 1);
+                type = WORDLE_IN_JOIN;
+            }
+        }
+    }
+    cJSON_Delete(json);
+    return type;
+}
+#endif
+
+// Checks every sample parses as expected (exit 1 if not), then times the
+// three messages clients actually send. The parser's time includes copying
+// the frame into a scratch buffer, since it writes over its input.
+static int bench_inbound(void)
+{
+    int failures = 0;
+    for (size_t i = 0; i < INBOUND_COUNT; i++) {
+        char buf[128];
+        size_t len = strlen(inbound[i].text);
+        memcpy(buf, inbound[i].text, len);
+        wordle_in_msg_t msg;
+        wordle_in_type_t type = wordle_parse_inbound(buf, len, &msg);
+        bool word_ok = type == WORDLE_IN_GUESS && msg.word_ok;
+        if (type != inbound[i].type || word_ok != inbound[i].word_ok) {
+            printf("parse mismatch: %s -> type %d word_ok %d\n", inbound[i].text, type, word_ok);
+            failures++;
+        }
+    }
+
+    printf("\n");
+    for (size_t i = 0; i < 3; i++) {
+        const char *text = inbound[i].text;
+        size_t len = strlen(text);
+        char name[64];
+        char buf[128];
+        wordle_in_msg_t msg;
+        uint64_t start = bench_now_ns();
+        for (int r = 0; r < PARSE_REPEAT; r++) {
+            memcpy(buf, text, len);
+            bench_sink += wordle_parse_inbound(buf, len, &msg);
+        }
+        snprintf(name, sizeof(name), "parse %.*s", (int)(strchr(text + 9, '"') - (text + 9)), text + 9);
+        bench_report(name, PARSE_REPEAT, bench_now_ns() - start);
+
+#ifdef WORDLE_HAVE_CJSON
+        char field[32];
+        start = bench_now_ns();
+        for (int r = 0; r < PARSE_REPEAT; r++) {
+            bench_sink += cjson_decode(text, len, field, sizeof(field));
+        }
+        snprintf(name, sizeof(name), "cjson %.*s", (int)(strchr(text + 9, '"') - (text + 9)), text + 9);
+        bench_report(name, PARSE_REPEAT, bench_now_ns() - start);
+#endif
+    }
+#ifndef WORDLE_HAVE_CJSON
+    printf("(built without cJSON, no cJSON parse rows)\n");
+#endif
+    return failures;
+}
+
+int main(void)
+{
+    wordle_word_t target;
+    wordle_pack(TARGET, &target);
+    wordle_pack(GUESS, &samples[4].msg.result.packed);
+    samples[4].msg.result.code = wordle_feedback(samples[4].msg.result.packed, target);
+
+    printf("Bytes on air per message (payload + %d-byte WS header)\n", WS_HEADER_LEN);
+    printf("%-20s %8s %8s %8s\n", "type", "binary", "json", "pretty");
+
+    uint64_t round_bin = 0, round_json = 0, round_pretty = 0;
+    for (size_t i = 0; i < SAMPLE_COUNT; i++) {
+        uint8_t buf[WORDLE_BIN_MAX_LEN];
+        size_t bin = wordle_msg_to_binary(&samples[i].msg, buf) + WS_HEADER_LEN;
+        size_t json = 0, pretty = 0;
+#ifdef WORDLE_HAVE_CJSON
+        cJSON *tree = wordle_msg_to_cjson(&samples[i].msg);
+        char *s = cJSON_PrintUnformatted(tree);
+        char *p = cJSON_Print(tree);
+        json = strlen(s) + WS_HEADER_LEN;
+        pretty = strlen(p) + WS_HEADER_LEN;
+        free(s);
+        free(p);
+        cJSON_Delete(tree);
+#endif
+        printf("%-20s %8zu %8zu %8zu\n", samples[i].name, bin, json, pretty);
+        round_bin += bin * samples[i].per_round;
+        round_json += json * samples[i].per_round;
+        round_pretty += pretty * samples[i].per_round;
+    }
+    printf("%-20s %8llu %8llu %8llu\n\n", "one round, 1 player",
+           (unsigned long long)round_bin, (unsigned long long)round_json,
+           (unsigned long long)round_pretty);
+#ifndef WORDLE_HAVE_CJSON
+    printf("(built without cJSON, JSON columns are empty)\n\n");
+#endif
+
+    for (size_t i = 0; i < SAMPLE_COUNT; i++) {
+        char name[64];
+        uint8_t buf[WORDLE_BIN_MAX_LEN];
+        uint64_t start = bench_now_ns();
+        for (int r = 0; r < ENCODE_REPEAT; r++) {
+            bench_sink += wordle_msg_to_binary(&samples[i].msg, buf);
+        }
+        snprintf(name, sizeof(name), "binary %s", samples[i].name);
+        bench_report(name, ENCODE_REPEAT, bench_now_ns() - start);
+
+#ifdef WORDLE_HAVE_CJSON
+        start = bench_now_ns();
+        for (int r = 0; r < ENCODE_REPEAT; r++) {
+            char *s = wordle_msg_to_json(&samples[i].msg);
+            bench_sink += (uintptr_t)s;
+            free(s);
+        }
+        snprintf(name, sizeof(name), "json %s", samples[i].name);
+        bench_report(name, ENCODE_REPEAT, bench_now_ns() - start);
+#endif
+    }
+
+    bench_spectators();
+    return bench_inbound() ? 1 : 0;
+}
@@ -0,0 +1,272 @@
+// Message dispatch cost against the number of occupied rooms. The fd index
+// should keep lookup and dispatch flat; the linear scan column is what the
+// old per-player fd comparison costs when spread over many rooms. Also what
+// keeping the leaderboard adds to each round end, and picking each round's word.
+// First checks that a room paired again starts its round 1, that asking for
+// the bot never pairs with an idle connection instead, that a full
+// leaderboard keeps both of a round's new names, and that rooms of two word
+// lengths pair and play side by side.
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "wordle_server.h"
+#include "wordle_stats.h"
+#include "wordle_words.h"
+#include "bench_util.h"
+
+#define FD_BASE     3
+#define LOOKUPS     4000000
+#define GUESSES     1000000
+#define RECORDS     1000000
+
+static wordle_server_t server;
+
+static game_state_t *linear_lookup(int fd, int *slot)
+{
+    for (int r = 0; r < WORDLE_MAX_ROOMS; r++) {
+        int p = wordle_find_player(&server.rooms[r], fd);
+        if (p >= 0) {
+            *slot = p;
+            return &server.rooms[r];
+        }
+    }
+    return NULL;
+}
+
+static void fill_rooms(int rooms)
+{
+    wordle_server_init(&server, FD_BASE, NULL, NULL);
+    for (int i = 0; i < rooms * WORDLE_MAX_PLAYERS; i++) {
+        int slot;
+        game_state_t *room = wordle_server_connect(&server, FD_BASE + i, NULL, &slot);
+        if (wordle_handle_join(room, slot, "bench")) {
+            wordle_start_new_round(room);
+        }
+    }
+}
+
+static double ns_per_op(uint64_t ops, uint64_t elapsed)
+{
+    return (double)elapsed / (double)ops;
+}
+
+// Round ends from twice as many names as the leaderboard holds, so about
+// half the records evict someone
+static void bench_stats(void)
+{
+    static wordle_stats_t stats;
+    static game_state_t game;
+    wordle_stats_init(&stats);
+    wordle_game_init(&game, NULL, NULL);
+    game.target_packed = wordle_answers[0];
+
+    uint64_t start = bench_now_ns();
+    for (int i = 0; i < RECORDS; i++) {
+        for (int p = 0; p < WORDLE_MAX_PLAYERS; p++) {
+            snprintf(game.players[p].name, sizeof(game.players[p].name), "player%d",
+                     (i * 7 + p * 13) % (WORDLE_STATS_PLAYERS * 2));
+            game.players[p].guesses_used = 1 + (i + p) % WORDLE_MAX_GUESSES;
+            game.players[p].has_won = (i + p) % 3 == 0;
+        }
+        wordle_stats_record(&stats, &game, i % 3 - 1);
+    }
+    printf("\nstats record: %.1f ns/round (%d-entry table)\n",
+           ns_per_op(RECORDS, bench_now_ns() - start), WORDLE_STATS_PLAYERS);
+
+    uint8_t order[WORDLE_STATS_PLAYERS];
+    start = bench_now_ns();
+    int count = 0;
+    for (int i = 0; i < RECORDS / 100; i++) {
+        count += wordle_stats_rank(&stats, order, WORDLE_STATS_PLAYERS);
+    }
+    bench_sink = count;
+    printf("stats rank: %.1f ns/call\n", ns_per_op(RECORDS / 100, bench_now_ns() - start));
+}
+
+// Word draws across the tiers, reshuffles included
+static void bench_deck(void)
+{
+    static wordle_deck_t deck;
+    wordle_deck_init(&deck, 1);
+    uint64_t acc = 0;
+    uint64_t start = bench_now_ns();
+    for (int i = 0; i < RECORDS; i++) {
+        acc += wordle_deck_draw(&deck, wordle_round_tier(i + 1));
+    }
+    bench_sink = acc;
+    printf("deck draw: %.1f ns/round\n", ns_per_op(RECORDS, bench_now_ns() - start));
+}
+
+// A player leaves mid-match and a newcomer takes the seat: the new pair's
+// round 1 has to start even though the room has played rounds before
+static bool check_rejoin(void)
+{
+    int slot;
+    wordle_server_init(&server, FD_BASE, NULL, NULL);
+    game_state_t *room = wordle_server_connect(&server, FD_BASE, NULL, &slot);
+    wordle_handle_join(room, slot, "stays");
+    wordle_server_connect(&server, FD_BASE + 1, NULL, &slot);
+    bool ok = wordle_handle_join(room, slot, "leaves") && wordle_start_first_round(room);
+    ok &= !wordle_start_first_round(room);  // Only once
+
+    wordle_server_disconnect(&server, FD_BASE + 1, false);
+    ok &= !room->game_active && !wordle_start_first_round(room);
+    ok &= wordle_server_connect(&server, FD_BASE + 2, NULL, &slot) == room;
+    ok &= wordle_handle_join(room, slot, "newcomer") && wordle_start_first_round(room);
+    ok &= room->game_active && !room->round_over && room->round_number == 2;
+    printf("%-36s %s\n", "leave, rejoin, round 1 starts", ok ? "ok" : "FAILED");
+    return ok;
+}
+
+// A second connection lands in the room before its first player asks for the
+// bot: the idle one moves on and the bot still takes the seat
+static bool check_bot_join(void)
+{
+    int slot;
+    int idle_slot;
+    int moved;
+    wordle_server_init(&server, FD_BASE, NULL, NULL);
+    game_state_t *room = wordle_server_connect(&server, FD_BASE, NULL, &slot);
+    bool ok = wordle_server_connect(&server, FD_BASE + 1, NULL, &idle_slot) == room;
+    ok &= wordle_server_add_bot(&server, room, slot, &moved) && moved == FD_BASE + 1;
+    ok &= wordle_find_player(room, WORDLE_BOT_FD(0)) >= 0;
+    game_state_t *elsewhere = wordle_server_lookup(&server, FD_BASE + 1, &idle_slot);
+    ok &= elsewhere != NULL && elsewhere != room && server.rooms_in_use == 2;
+    ok &= wordle_handle_join(room, slot, "solo") && wordle_start_first_round(room);
+
+    // One who has joined keeps the seat
+    game_state_t *other = wordle_server_connect(&server, FD_BASE + 2, NULL, &slot);
+    ok &= other == elsewhere;
+    wordle_handle_join(elsewhere, idle_slot, "waiting");
+    ok &= !wordle_server_add_bot(&server, other, slot, &moved) && moved < 0;
+    printf("%-36s %s\n", "bot join moves an idle connection", ok ? "ok" : "FAILED");
+    return ok;
+}
+
+// Two names the leaderboard has never seen, one round, a full table: both
+// get an entry and the winner keeps the win
+static bool check_stats_eviction(void)
+{
+    static wordle_stats_t stats;
+    static game_state_t game;
+    wordle_stats_init(&stats);
+    wordle_game_init(&game, NULL, NULL);
+    for (int round = 0; round < 2; round++) {
+        for (int i = 0; i + 1 < WORDLE_STATS_PLAYERS; i += 2) {
+            snprintf(game.players[0].name, sizeof(game.players[0].name), "old%d", i);
+            snprintf(game.players[1].name, sizeof(game.players[1].name), "old%d", i + 1);
+            wordle_stats_record(&stats, &game, -1);
+        }
+    }
+
+    strcpy(game.players[0].name, "NEW1");
+    strcpy(game.players[1].name, "NEW2");
+    wordle_stats_record(&stats, &game, 0);
+    bool found[WORDLE_MAX_PLAYERS] = { false };
+    for (int i = 0; i < WORDLE_STATS_PLAYERS; i++) {
+        const wordle_stats_entry_t *e = &stats.entries[i];
+        found[0] |= strcmp(e->name, "NEW1") == 0 && e->played == 1 && e->wins == 1;
+        found[1] |= strcmp(e->name, "NEW2") == 0 && e->played == 1 && e->wins == 0;
+    }
+    bool ok = WORDLE_STATS_PLAYERS < 2 || (found[0] && found[1]);
+    printf("%-36s %s\n", "full leaderboard, two new names", ok ? "ok" : "FAILED");
+    return ok;
+}
+
+// Players asking for the shortest and the longest length built: each pairs
+// with its own kind, and each room scores words of its length only
+static bool check_variants(void)
+{
+    const wordle_variant_t *short_v = wordle_variants[0];
+    const wordle_variant_t *long_v = wordle_variants[WORDLE_VARIANT_COUNT - 1];
+    if (short_v == long_v) {
+        return true;  // One length built, nothing to mix
+    }
+    int slot;
+    wordle_server_init(&server, FD_BASE, NULL, NULL);
+    game_state_t *a = wordle_server_connect(&server, FD_BASE, short_v, &slot);
+    wordle_handle_join(a, slot, "short1");
+    game_state_t *b = wordle_server_connect(&server, FD_BASE + 1, long_v, &slot);
+    wordle_handle_join(b, slot, "long1");
+    bool ok = a != b && a->variant == short_v && b->variant == long_v;
+    ok &= wordle_server_connect(&server, FD_BASE + 2, long_v, &slot) == b;
+    ok &= wordle_handle_join(b, slot, "long2") && wordle_start_first_round(b);
+    ok &= wordle_server_connect(&server, FD_BASE + 3, short_v, &slot) == a;
+    ok &= wordle_handle_join(a, slot, "short2") && wordle_start_first_round(a);
+    ok &= (int)strlen(a->target_word) == short_v->word_len && (int)strlen(b->target_word) == long_v->word_len;
+
+    // Each room's own answer scores; the other length's word is turned back
+    char word[WORDLE_MAX_WORD_LEN + 1];
+    long_v->unpack(long_v->answers[0], word);
+    wordle_handle_packed_guess(a, slot, long_v->answers[0], long_v->word_len);
+    wordle_handle_guess(a, slot, word);
+    ok &= a->players[slot].row_count == 0;
+    short_v->unpack(a->target_packed, word);
+    wordle_handle_guess(a, slot, word);
+    ok &= a->players[slot].row_count == 1 && a->players[slot].has_won;
+    wordle_handle_packed_guess(b, slot, b->target_packed, long_v->word_len);
+    ok &= b->players[slot].row_count == 1 && b->players[slot].has_won;
+    printf("%-36s %s\n", "rooms of two word lengths", ok ? "ok" : "FAILED");
+    return ok;
+}
+
+int main(void)
+{
+    static const int room_counts[] = {1, 4, 16, 64, 256, 1024};
+    char guess[WORDLE_WORD_LEN + 1];
+
+    if (!check_rejoin() || !check_bot_join() || !check_stats_eviction() || !check_variants()) {
+        return 1;
+    }
+
+    printf("%8s %14s %14s %14s\n", "rooms", "lookup ns", "linear ns", "dispatch ns");
+    for (size_t c = 0; c < sizeof(room_counts) / sizeof(room_counts[0]); c++) {
+        int rooms = room_counts[c];
+        if (rooms > WORDLE_MAX_ROOMS) {
+            break;
+        }
+        fill_rooms(rooms);
+        int fds = rooms * WORDLE_MAX_PLAYERS;
+        uint64_t acc = 0;
+        int slot = 0;
+
+        uint32_t seed = 1;
+        uint64_t start = bench_now_ns();
+        for (int i = 0; i < LOOKUPS; i++) {
+            seed = seed * 1664525u + 1013904223u;
+            acc += (uintptr_t)wordle_server_lookup(&server, FD_BASE + (int)((seed >> 8) % fds), &slot) + slot;
+        }
+        double lookup_ns = ns_per_op(LOOKUPS, bench_now_ns() - start);
+
+        // The scan gets slow quickly, so it runs fewer iterations
+        int scans = LOOKUPS / (rooms < 64 ? 1 : rooms / 16);
+        seed = 1;
+        start = bench_now_ns();
+        for (int i = 0; i < scans; i++) {
+            seed = seed * 1664525u + 1013904223u;
+            acc += (uintptr_t)linear_lookup(FD_BASE + (int)((seed >> 8) % fds), &slot) + slot;
+        }
+        double linear_ns = ns_per_op(scans, bench_now_ns() - start);
+
+        // Lookup plus the full guess path, restarting rounds as they finish
+        seed = 1;
+        start = bench_now_ns();
+        for (int i = 0; i < GUESSES; i++) {
+            seed = seed * 1664525u + 1013904223u;
+            game_state_t *room = wordle_server_lookup(&server, FD_BASE + (int)((seed >> 8) % fds), &slot);
+            wordle_unpack(wordle_answers[(seed >> 4) % WORDLE_ANSWER_COUNT], guess);
+            wordle_handle_guess(room, slot, guess);
+            if (room->round_over) {
+                wordle_start_new_round(room);
+            }
+        }
+        double dispatch_ns = ns_per_op(GUESSES, bench_now_ns() - start);
+        bench_sink = acc;
+
+        printf("%8d %14.1f %14.1f %14.1f\n", rooms, lookup_ns, linear_ns, dispatch_ns);
+    }
+    bench_stats();
+    bench_deck();
+    return 0;
+}
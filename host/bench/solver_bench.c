@@ -0,0 +1,110 @@
+// Batch solve: the entropy bot against every word in the answer list, scored
+// the way the engine scores a round (WORDLE_MAX_GUESSES tries). Also compares
+// catch-up hint strength with the old random-letter pick.
+#include <math.h>
+#include <stdio.h>
+#include "wordle_engine.h"
+#include "wordle_fb_matrix.h"
+#include "wordle_solver.h"
+#include "wordle_hint.h"
+#include "bench_util.h"
+
+#define MAX_TRACKED 12   // Longest solve the distribution has a column for
+
+// Information a hint is worth, in bits
+static double hint_bits(uint16_t remaining)
+{
+    return log2((double)WORDLE_ANSWER_COUNT / remaining);
+}
+
+// Spread of hint strength over every answer at a given score gap: the old
+// pick (any letter of the answer, uniformly) against wordle_hint_pick
+static void bench_hints(int gap)
+{
+    bool green = gap >= WORDLE_HINT_GREEN_GAP;
+    double old_sum = 0, old_sq = 0, new_sum = 0, new_sq = 0;
+    for (uint16_t t = 0; t < WORDLE_ANSWER_COUNT; t++) {
+        for (int i = 0; i < WORDLE_WORD_LEN; i++) {
+            unsigned letter = wordle_letter(wordle_answers[t], i);
+            double bits = hint_bits(green ? wordle_position_answers[i][letter] : wordle_letter_answers[letter]);
+            old_sum += bits;
+            old_sq += bits * bits;
+        }
+        wordle_hint_t hint;
+        wordle_hint_pick(wordle_answers[t], gap, &hint);
+        double bits = hint_bits(hint.remaining);
+        new_sum += bits;
+        new_sq += bits * bits;
+    }
+    double old_mean = old_sum / ((double)WORDLE_WORD_LEN * WORDLE_ANSWER_COUNT);
+    double new_mean = new_sum / WORDLE_ANSWER_COUNT;
+    char name[40];
+    snprintf(name, sizeof(name), "hint bits, gap %d (target %.2f)", gap, log2(gap + 1.0));
+    printf("%-36s random %.2f +- %.2f   picked %.2f +- %.2f\n", name,
+           old_mean, sqrt(old_sq / ((double)WORDLE_WORD_LEN * WORDLE_ANSWER_COUNT) - old_mean * old_mean),
+           new_mean, sqrt(new_sq / WORDLE_ANSWER_COUNT - new_mean * new_mean));
+}
+
+int main(void)
+{
+    wordle_solver_t solver;
+
+    // The opening is computed once and cached, time it on its own
+    wordle_solver_reset(&solver);
+    uint64_t start = bench_now_ns();
+    uint16_t opening = wordle_solver_best_guess(&solver);
+    uint64_t opening_ns = bench_now_ns() - start;
+    char word[WORDLE_WORD_LEN + 1];
+    wordle_unpack(wordle_answers[opening], word);
+    printf("%-36s %12s\n", "opening guess", word);
+    bench_report("opening guess (full list)", 1, opening_ns);
+
+    unsigned histogram[MAX_TRACKED + 1] = {0};
+    uint64_t total_guesses = 0;
+    unsigned worst = 0;
+    unsigned failed = 0;
+
+    start = bench_now_ns();
+    for (uint16_t target = 0; target < WORDLE_ANSWER_COUNT; target++) {
+        wordle_solver_reset(&solver);
+        unsigned guesses = 0;
+        wordle_fb_t code;
+        do {
+            uint16_t guess = wordle_solver_best_guess(&solver);
+            code = wordle_fb_lookup(guess, target);
+            wordle_solver_filter(&solver, guess, code);
+            guesses++;
+        } while (code != WORDLE_FB_ALL_GREEN && guesses <= MAX_TRACKED);
+
+        total_guesses += guesses;
+        histogram[guesses <= MAX_TRACKED ? guesses : MAX_TRACKED]++;
+        worst = guesses > worst ? guesses : worst;
+        failed += guesses > WORDLE_MAX_GUESSES;
+    }
+    uint64_t elapsed = bench_now_ns() - start;
+
+    bench_report("solve (per answer)", WORDLE_ANSWER_COUNT, elapsed);
+    printf("%-36s %12.3f\n", "mean guesses", (double)total_guesses / WORDLE_ANSWER_COUNT);
+    printf("%-36s %12u\n", "worst case", worst);
+    printf("%-36s %12u of %d\n", "over the guess limit", failed, WORDLE_ANSWER_COUNT);
+    printf("%-36s", "distribution");
+    for (unsigned g = 1; g <= worst && g <= MAX_TRACKED; g++) {
+        printf(" %u:%u", g, histogram[g]);
+    }
+    printf("\n");
+
+    bench_hints(2);
+    bench_hints(3);
+    bench_hints(4);
+    bench_hints(6);
+
+    wordle_hint_t hint;
+    const uint64_t picks = 1000000;
+    start = bench_now_ns();
+    for (uint64_t i = 0; i < picks; i++) {
+        wordle_hint_pick(wordle_answers[i % WORDLE_ANSWER_COUNT], 2 + (int)(i & 3), &hint);
+        bench_sink += hint.remaining;
+    }
+    bench_report("wordle_hint_pick", picks, bench_now_ns() - start);
+    return failed ? 1 : 0;
+}
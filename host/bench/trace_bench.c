@@ -0,0 +1,117 @@
+// What the hot path paid for ESP_LOGI per guess versus what it pays for the
+// binary trace now. The log side formats the same lines the old handlers
+// printed for one guess (ESP_LOG prefix included) and writes them to
+// /dev/null; on the device those bytes also have to leave through the
+// console UART, which the report models at 115200 baud. The /metrics
+// latency histogram sits on the same path, so its cost is reported too.
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "wordle_trace.h"
+#include "wordle_metrics.h"
+#include "bench_util.h"
+
+#define GUESSES      200000
+#define UART_BAUD    115200
+#define UART_BITS    10        // 8N1 framing per byte
+
+static FILE *sink;
+static uint64_t log_bytes;
+
+// esp_log_write() in miniature: level letter, timestamp, tag, message
+static void fake_logi(const char *tag, const char *fmt, ...)
+{
+    char line[256];
+    va_list ap;
+    int n = snprintf(line, sizeof(line), "I (%lu) %s: ", (unsigned long)(bench_now_ns() / 1000000), tag);
+    va_start(ap, fmt);
+    n += vsnprintf(line + n, sizeof(line) - n, fmt, ap);
+    va_end(ap);
+    line[n++] = '\n';
+    fwrite(line, 1, n, sink);
+    log_bytes += n;
+}
+
+// The lines one guess produced before the trace: frame in, message type,
+// engine, and one "Sent" per coalesced frame (every other guess completes a
+// turn and adds a line)
+static void guess_with_logs(int g)
+{
+    fake_logi("wifi softAP", "Received packet with length %d", 32);
+    fake_logi("wifi softAP", "Got message: %s", "{\"type\":\"guess\",\"word\":\"CRANE\"}");
+    fake_logi("wifi softAP", "Message type: %s", "guess");
+    fake_logi("wordle engine", "Player %d guessed: %s", g & 1 ? 2 : 1, "CRANE");
+    if (g & 1) {
+        fake_logi("wordle engine", "Both players submitted their guesses");
+    }
+    fake_logi("wifi softAP", "Sent to fd %d: %d messages, %d bytes", 54, 2, 9);
+    fake_logi("wifi softAP", "Sent to fd %d: %d messages, %d bytes", 55, 2, 3);
+}
+
+// The same guess with tracing at level 2 (frames included)
+static void guess_with_trace(int g)
+{
+    wordle_trace_write(WORDLE_EV_WS_RX, 54, 32, 0);
+    wordle_trace_write(WORDLE_EV_GUESS, 54, 20 << 8 | (g & 1), 0x1234567);
+    if (g & 1) {
+        wordle_trace_write(WORDLE_EV_TURN_DONE, -1, 3, 0x0101);
+    }
+    wordle_trace_write(WORDLE_EV_WS_TX, 54, 2, 9);
+    wordle_trace_write(WORDLE_EV_WS_TX, 55, 2, 3);
+}
+
+int main(void)
+{
+    sink = fopen("/dev/null", "w");
+    if (sink == NULL) {
+        perror("/dev/null");
+        return 1;
+    }
+
+    uint64_t start = bench_now_ns();
+    for (int g = 0; g < GUESSES; g++) {
+        guess_with_logs(g);
+    }
+    uint64_t log_ns = bench_now_ns() - start;
+
+    start = bench_now_ns();
+    for (int g = 0; g < GUESSES; g++) {
+        guess_with_trace(g);
+    }
+    uint64_t trace_ns = bench_now_ns() - start;
+
+    wordle_hist_t hist = {0};
+    uint32_t seed = 4242;
+    start = bench_now_ns();
+    for (int g = 0; g < GUESSES; g++) {
+        seed = seed * 1664525u + 1013904223u;
+        wordle_hist_add(&hist, seed >> 12);
+    }
+    uint64_t hist_ns = bench_now_ns() - start;
+    for (int i = 0; i < WORDLE_HIST_BUCKETS; i++) {
+        bench_sink += hist.buckets[i];
+    }
+
+    bench_report("per guess, ESP_LOGI formatting", GUESSES, log_ns);
+    bench_report("per guess, binary trace", GUESSES, trace_ns);
+    bench_report("per event, latency histogram", GUESSES, hist_ns);
+
+    double bytes_per_guess = (double)log_bytes / GUESSES;
+    double uart_us = bytes_per_guess * UART_BITS * 1e6 / UART_BAUD;
+    printf("%-36s %12.1f bytes\n", "log output per guess", bytes_per_guess);
+    printf("%-36s %12.1f us\n", "console UART time per guess", uart_us);
+
+    // Show the decoder output for one guess
+    char line[96];
+    uint32_t head = wordle_trace_head();
+    printf("\nlast traced guess:\n");
+    for (uint32_t seq = head - 5; seq < head; seq++) {
+        wordle_trace_entry_t entry;
+        wordle_trace_read(seq, &entry);
+        wordle_trace_format(&entry, line, sizeof(line));
+        fputs(line, stdout);
+    }
+
+    fclose(sink);
+    return 0;
+}
@@ -0,0 +1,390 @@
+// Engine microbenchmarks. Numbers are host numbers: use them to compare
+// changes against each other, not as a prediction of ESP32 timings.
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "wordle_engine.h"
+#include "wordle_fb_matrix.h"
+#include "wordle_dict.h"
+#include "wordle_words.h"
+#include "wordle_outq.h"
+#include "wordle_cands.h"
+#include "bench_util.h"
+
+#define CHECK_GUESS_REPEAT  20   // all-pairs passes for the per-call figure
+#define GAME_ROUNDS         20000
+
+// The original nested-loop check_guess, kept as the reference the packed
+// kernel is verified and measured against.
+static void reference_check_guess(const char *guess, const char *target, int *result)
+{
+    bool target_used[WORDLE_WORD_LEN] = {false};
+    bool guess_used[WORDLE_WORD_LEN] = {false};
+
+    for (int i = 0; i < WORDLE_WORD_LEN; i++) {
+        if (guess[i] == target[i]) {
+            result[i] = 2;
+            target_used[i] = true;
+            guess_used[i] = true;
+        } else {
+            result[i] = 0;
+        }
+    }
+
+    for (int i = 0; i < WORDLE_WORD_LEN; i++) {
+        if (guess_used[i]) continue;
+
+        for (int j = 0; j < WORDLE_WORD_LEN; j++) {
+            if (!target_used[j] && guess[i] == target[j]) {
+                result[i] = 1;
+                target_used[j] = true;
+                break;
+            }
+        }
+    }
+}
+
+// Answer list as strings for the reference implementation, and packed
+static char word_text[WORDLE_ANSWER_COUNT][WORDLE_WORD_LEN + 1];
+static const char *words[WORDLE_ANSWER_COUNT];
+static const wordle_word_t *packed = wordle_answers;
+static const size_t word_count = WORDLE_ANSWER_COUNT;
+
+static void load_words(void)
+{
+    for (size_t i = 0; i < word_count; i++) {
+        wordle_unpack(wordle_answers[i], word_text[i]);
+        words[i] = word_text[i];
+    }
+    printf("Answer list: %zu words, %zu pairs\n", word_count, word_count * word_count);
+}
+
+// Exhaustive check that the packed kernel reproduces the reference exactly
+static bool verify_feedback(void)
+{
+    size_t mismatches = 0;
+    for (size_t g = 0; g < word_count; g++) {
+        for (size_t a = 0; a < word_count; a++) {
+            int expected[WORDLE_WORD_LEN];
+            int actual[WORDLE_WORD_LEN];
+            reference_check_guess(words[g], words[a], expected);
+            wordle_fb_expand(wordle_feedback(packed[g], packed[a]), actual);
+            if (memcmp(expected, actual, sizeof(expected)) != 0) {
+                if (mismatches++ < 10) {
+                    printf("MISMATCH guess %s answer %s\n", words[g], words[a]);
+                }
+            }
+        }
+    }
+    printf("%-36s %12zu pairs %s\n", "feedback kernel vs reference",
+           word_count * word_count, mismatches ? "FAILED" : "bit-exact");
+    return mismatches == 0;
+}
+
+static void bench_check_guess(void)
+{
+    const size_t n = word_count;
+    int result[WORDLE_WORD_LEN];
+    uint64_t acc = 0;
+
+    // One all-pairs sweep with each implementation
+    uint64_t start = bench_now_ns();
+    for (size_t g = 0; g < n; g++) {
+        for (size_t a = 0; a < n; a++) {
+            reference_check_guess(words[g], words[a], result);
+            acc += result[0] + result[WORDLE_WORD_LEN - 1];
+        }
+    }
+    bench_report("all-pairs reference (1 sweep)", n * n, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (size_t g = 0; g < n; g++) {
+        for (size_t a = 0; a < n; a++) {
+            acc += wordle_feedback(packed[g], packed[a]);
+        }
+    }
+    bench_report("all-pairs packed kernel (1 sweep)", n * n, bench_now_ns() - start);
+
+    // Repeated sweeps for a stable per-call figure
+    start = bench_now_ns();
+    for (int r = 0; r < CHECK_GUESS_REPEAT; r++) {
+        for (size_t g = 0; g < n; g++) {
+            for (size_t a = 0; a < n; a++) {
+                reference_check_guess(words[g], words[a], result);
+                acc += result[0] + result[WORDLE_WORD_LEN - 1];
+            }
+        }
+    }
+    bench_report("reference check_guess", (uint64_t)CHECK_GUESS_REPEAT * n * n, bench_now_ns() - start);
+
+    start = bench_now_ns();
+    for (int r = 0; r < CHECK_GUESS_REPEAT; r++) {
+        for (size_t g = 0; g < n; g++) {
+            for (size_t a = 0; a < n; a++) {
+                acc += wordle_feedback(packed[g], packed[a]);
+            }
+        }
+    }
+    bench_report("packed kernel", (uint64_t)CHECK_GUESS_REPEAT * n * n, bench_now_ns() - start);
+
+    // The kernel plus the int[WORDLE_WORD_LEN] expansion the JSON edge still needs
+    start = bench_now_ns();
+    for (int r = 0; r < CHECK_GUESS_REPEAT; r++) {
+        for (size_t g = 0; g < n; g++) {
+            for (size_t a = 0; a < n; a++) {
+                wordle_fb_expand(wordle_feedback(packed[g], packed[a]), result);
+                acc += result[0] + result[WORDLE_WORD_LEN - 1];
+            }
+        }
+    }
+    bench_report("packed kernel + expand", (uint64_t)CHECK_GUESS_REPEAT * n * n, bench_now_ns() - start);
+    bench_sink = acc;
+}
+
+// Matrix lookups against the kernel, over answer indices
+static bool bench_fb_matrix(void)
+{
+    const size_t n = word_count;
+    size_t bytes = wordle_fb_matrix_bytes();
+    if (bytes) {
+        printf("%-36s %12zu bytes (%zu x %zu)\n", "feedback matrix in flash", bytes, n, n);
+    } else {
+        printf("%-36s %12s\n", "feedback matrix", "not embedded, computed");
+    }
+
+    size_t mismatches = 0;
+    for (size_t g = 0; g < n; g++) {
+        for (size_t a = 0; a < n; a++) {
+            if (wordle_fb_lookup(g, a) != wordle_feedback(packed[g], packed[a])) {
+                mismatches++;
+            }
+        }
+    }
+    printf("%-36s %12zu pairs %s\n", "matrix vs kernel", n * n, mismatches ? "FAILED" : "identical");
+
+    // Random pairs, the access pattern a solver or hint search actually has
+    const uint64_t lookups = (uint64_t)CHECK_GUESS_REPEAT * n * n;
+    uint64_t acc = 0;
+    uint32_t seed = 12345;
+    uint64_t start = bench_now_ns();
+    for (uint64_t i = 0; i < lookups; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        acc += wordle_fb_lookup((seed >> 8) % n, (seed >> 20) % n);
+    }
+    bench_report("wordle_fb_lookup (random pairs)", lookups, bench_now_ns() - start);
+
+    seed = 12345;
+    start = bench_now_ns();
+    for (uint64_t i = 0; i < lookups; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        acc += wordle_feedback(packed[(seed >> 8) % n], packed[(seed >> 20) % n]);
+    }
+    bench_report("wordle_feedback (random pairs)", lookups, bench_now_ns() - start);
+    bench_sink = acc;
+    return mismatches == 0;
+}
+
+// Allowed-guess dictionary: flash cost and membership latency
+static bool bench_dictionary(void)
+{
+    size_t n = wordle_dict_count;
+    printf("%-36s %12zu words %8zu bytes flash (vs %zu as char* table)\n", "allowed-guess dictionary",
+           n, wordle_dict_bytes(), n * (sizeof(char *) + WORDLE_WORD_LEN + 1));
+
+    // Every answer must be guessable, and random keys must agree with a linear scan
+    size_t errors = 0;
+    for (size_t i = 0; i < word_count; i++) {
+        errors += !wordle_dict_contains(packed[i]);
+    }
+    uint32_t seed = 777;
+    for (int i = 0; i < 20000; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        wordle_word_t key = seed >> 7;
+        bool linear = false;
+        for (size_t k = 1; k <= n; k++) {
+            linear |= (wordle_dict_tree[k] == key);
+        }
+        errors += (linear != wordle_dict_contains(key));
+    }
+    printf("%-36s %12s\n", "dictionary membership", errors ? "FAILED" : "ok");
+
+    const uint64_t lookups = 5000000;
+    uint64_t hits = 0;
+    uint64_t start = bench_now_ns();
+    for (uint64_t i = 0; i < lookups; i++) {
+        hits += wordle_dict_contains(wordle_dict_tree[1 + i % n]);
+    }
+    bench_report("wordle_dict_contains (hit)", lookups, bench_now_ns() - start);
+
+    seed = 99;
+    start = bench_now_ns();
+    for (uint64_t i = 0; i < lookups; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        hits += wordle_dict_contains(seed >> 7);
+    }
+    bench_report("wordle_dict_contains (random key)", lookups, bench_now_ns() - start);
+    bench_sink = hits;
+    return errors == 0;
+}
+
+// Candidate bitsets: one apply must keep exactly the answers a rescan with
+// the kernel keeps, for answer guesses and a sample of other allowed words
+static bool verify_cands_for(wordle_word_t guess)
+{
+    wordle_cands_t expected[WORDLE_FB_CODES];
+    bool seen[WORDLE_FB_CODES] = {false};
+    for (size_t a = 0; a < word_count; a++) {
+        wordle_fb_t code = wordle_feedback(guess, packed[a]);
+        if (!seen[code]) {
+            seen[code] = true;
+            memset(&expected[code], 0, sizeof(expected[code]));
+        }
+        expected[code].bits[a / 32] |= 1u << (a % 32);
+    }
+    for (int code = 0; code < WORDLE_FB_CODES; code++) {
+        wordle_cands_t cands;
+        wordle_cands_reset(&cands);
+        wordle_cands_apply(&cands, guess, (wordle_fb_t)code);
+        if (!seen[code]) {
+            memset(&expected[code], 0, sizeof(expected[code]));
+        }
+        if (memcmp(&cands, &expected[code], sizeof(cands)) != 0) {
+            char word[WORDLE_WORD_LEN + 1];
+            wordle_unpack(guess, word);
+            printf("MISMATCH candidates for %s code %d\n", word, code);
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool bench_cands(void)
+{
+    size_t checked = 0;
+    bool ok = true;
+    for (size_t g = 0; g < word_count && ok; g++, checked++) {
+        ok = verify_cands_for(packed[g]);
+    }
+    for (size_t k = 1; k <= wordle_dict_count && ok; k += 17, checked++) {
+        ok = verify_cands_for(wordle_dict_tree[k]);
+    }
+    printf("%-36s %12zu guesses x %d codes %s\n", "candidate bitset vs rescan", checked, WORDLE_FB_CODES, ok ? "identical" : "FAILED");
+
+    // A round's worth of updates: random guesses against random targets
+    const uint64_t updates = 1000000;
+    uint32_t seed = 2024;
+    wordle_cands_t cands;
+    wordle_cands_reset(&cands);
+    uint64_t acc = 0;
+    uint64_t start = bench_now_ns();
+    for (uint64_t i = 0; i < updates; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        if (i % WORDLE_MAX_GUESSES == 0) {
+            wordle_cands_reset(&cands);
+        }
+        wordle_word_t guess = packed[(seed >> 8) % word_count];
+        wordle_word_t target = packed[(seed >> 20) % word_count];
+        wordle_cands_apply(&cands, guess, wordle_feedback(guess, target));
+        acc += wordle_cands_count(&cands);
+    }
+    bench_report("wordle_cands_apply + count", updates, bench_now_ns() - start);
+
+    // What it replaces: filtering the answer list with the kernel
+    seed = 2024;
+    start = bench_now_ns();
+    for (uint64_t i = 0; i < updates / 10; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        wordle_word_t guess = packed[(seed >> 8) % word_count];
+        wordle_fb_t code = wordle_feedback(guess, packed[(seed >> 20) % word_count]);
+        for (size_t a = 0; a < word_count; a++) {
+            acc += wordle_feedback(guess, packed[a]) == code;
+        }
+    }
+    bench_report("full rescan with the kernel", updates / 10, bench_now_ns() - start);
+    bench_sink = acc;
+    return ok;
+}
+
+static uint64_t messages_sent;
+static uint64_t frames_sent;
+static wordle_outq_t bench_outq[WORDLE_MAX_PLAYERS];
+
+// Queue like the device transport, fds 1 and 2 are the two seats
+static void queue_send(void *ctx, int fd, const wordle_msg_t *msg)
+{
+    (void)ctx;
+    messages_sent++;
+    wordle_outq_push(&bench_outq[fd - 1], msg);
+}
+
+// End of event: what the sender task writes, one frame per non-empty queue
+static void flush_frames(void)
+{
+    wordle_msg_t msgs[WORDLE_OUTQ_LEN];
+    for (int p = 0; p < WORDLE_MAX_PLAYERS; p++) {
+        int fd;
+        if (wordle_outq_pop(&bench_outq[p], msgs, WORDLE_OUTQ_LEN, &fd) > 0) {
+            frames_sent++;
+        }
+    }
+}
+
+// Full engine path per guess: state checks, scoring, message construction and
+// queueing, with a transport that only counts frames.
+static void bench_game_guesses(void)
+{
+    game_state_t game;
+    wordle_game_init(&game, queue_send, NULL);
+    for (int p = 0; p < WORDLE_MAX_PLAYERS; p++) {
+        wordle_outq_reset(&bench_outq[p], p + 1);
+    }
+    wordle_add_player(&game, 1);
+    wordle_add_player(&game, 2);
+    wordle_handle_join(&game, 0, "bench1");
+    wordle_handle_join(&game, 1, "bench2");
+    flush_frames();
+
+    uint64_t guesses = 0;
+    messages_sent = 0;
+    frames_sent = 0;
+    size_t next_word = 0;
+
+    uint64_t start = bench_now_ns();
+    for (int round = 0; round < GAME_ROUNDS; round++) {
+        wordle_start_new_round(&game);
+        flush_frames();
+        while (!game.round_over) {
+            for (int p = 0; p < WORDLE_MAX_PLAYERS; p++) {
+                wordle_handle_guess(&game, p, words[next_word]);
+                flush_frames();
+                next_word = (next_word + 1) % word_count;
+                guesses++;
+            }
+        }
+    }
+    uint64_t elapsed = bench_now_ns() - start;
+
+    bench_report("engine guess (handle_guess)", guesses, elapsed);
+    printf("%-36s %12.2f\n", "messages per guess", (double)messages_sent / (double)guesses);
+    printf("%-36s %12.2f\n", "frames per guess (coalesced)", (double)frames_sent / (double)guesses);
+}
+
+int main(void)
+{
+    load_words();
+    if (!verify_feedback()) {
+        return 1;
+    }
+    bench_check_guess();
+    if (!bench_fb_matrix()) {
+        return 1;
+    }
+    if (!bench_dictionary()) {
+        return 1;
+    }
+    if (!bench_cands()) {
+        return 1;
+    }
+    bench_game_guesses();
+    return 0;
+}
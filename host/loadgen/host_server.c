@@ -0,0 +1,397 @@
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include "wordle_engine.h"
+#include "wordle_server.h"
+#include "wordle_proto.h"
+#include "wordle_outq.h"
+#include "wordle_inbound.h"
+#ifdef WORDLE_HAVE_CJSON
+#include "cJSON.h"
+#include "wordle_json.h"
+#endif
+#include "ws_shim.h"
+#include "host_server.h"
+
+#define CONN_RX_LEN   512
+#define SEND_TIMEOUT  2      // Seconds, the device's send_wait_timeout
+
+typedef struct {
+    int fd;
+    bool upgraded;
+    bool binary;             // Connected with ?proto=bin
+    size_t rx_len;
+    uint8_t rx[CONN_RX_LEN];
+} conn_t;
+
+static wordle_server_t game_server;
+static wordle_outq_t outq[WORDLE_MAX_ROOMS][WORDLE_MAX_PLAYERS];
+static int64_t deadline_us[WORDLE_MAX_ROOMS];    // Turn deadline, 0 = none
+static int64_t first_round_us[WORDLE_MAX_ROOMS]; // Pending round 1, 0 = none
+static int64_t hold_us[WORDLE_MAX_ROOMS][WORDLE_MAX_PLAYERS];     // Held seat's release, 0 = none
+static uint32_t hold_token[WORDLE_MAX_ROOMS][WORDLE_MAX_PLAYERS];
+static conn_t *conns[WORDLE_MAX_FDS];
+static int open_fds[WORDLE_MAX_FDS];
+static int open_count;
+static int join_delay_ms;
+static volatile sig_atomic_t stop;
+
+static int64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void on_signal(int sig)
+{
+    (void)sig;
+    stop = 1;
+}
+
+// Engine send hook: queue for the seat, written at the end of the event
+static void send_to_fd(void *ctx, int fd, const wordle_msg_t *msg)
+{
+    (void)ctx;
+    int slot;
+    game_state_t *room = wordle_server_lookup(&game_server, fd, &slot);
+    if (room != NULL) {
+        wordle_outq_push(&outq[room - game_server.rooms][slot], msg);
+    }
+}
+
+static void arm_deadline(void *ctx, game_state_t *game, uint32_t delay_ms)
+{
+    (void)ctx;
+    deadline_us[game - game_server.rooms] = delay_ms ? now_us() + (int64_t)delay_ms * 1000 : 0;
+}
+
+// Write one frame per seat with everything queued, what sender_task does
+static void flush_queues(void)
+{
+    wordle_msg_t msgs[WORDLE_OUTQ_LEN];
+    uint8_t bin[WORDLE_OUTQ_LEN * WORDLE_BIN_MAX_LEN];
+    for (int r = 0; r < WORDLE_MAX_ROOMS; r++) {
+        for (int p = 0; p < WORDLE_MAX_PLAYERS; p++) {
+            int fd;
+            int count = wordle_outq_pop(&outq[r][p], msgs, WORDLE_OUTQ_LEN, &fd);
+            if (count == 0 || conns[fd] == NULL) {
+                continue;
+            }
+            if (conns[fd]->binary) {
+                size_t len = wordle_msgs_to_binary(msgs, count, bin);
+                ws_send_frame(fd, WS_OP_BINARY, bin, len, 0);
+                continue;
+            }
+#ifdef WORDLE_HAVE_CJSON
+            char *text = wordle_msgs_to_json(msgs, count);
+            if (text != NULL) {
+                ws_send_frame(fd, WS_OP_TEXT, (uint8_t *)text, strlen(text), 0);
+                cJSON_free(text);
+            }
+#endif
+        }
+    }
+}
+
+// One client frame, parsed in place like the device does
+static void handle_text(int fd, char *text, size_t len)
+{
+    int slot;
+    game_state_t *room = wordle_server_lookup(&game_server, fd, &slot);
+    if (room == NULL) {
+        return;
+    }
+
+    wordle_in_msg_t msg;
+    switch (wordle_parse_inbound(text, len, &msg)) {
+    case WORDLE_IN_GUESS:
+        if (msg.word_ok) {
+            wordle_handle_packed_guess(room, slot, msg.packed, msg.word_len);
+        } else {
+            wordle_handle_guess(room, slot, msg.word);
+        }
+        break;
+    case WORDLE_IN_NEXT_ROUND:
+        wordle_handle_next_round(room);
+        break;
+    case WORDLE_IN_JOIN:
+        if (wordle_handle_join(room, slot, msg.name)) {
+            // Round 1 after the same pause as the device, from a timer so
+            // the other rooms keep moving while this one waits
+            first_round_us[room - game_server.rooms] = now_us() + (int64_t)join_delay_ms * 1000;
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+static void close_conn(int fd)
+{
+    int slot = -1;
+    game_state_t *room = wordle_server_lookup(&game_server, fd, &slot);
+    if (room != NULL) {
+        wordle_outq_reset(&outq[room - game_server.rooms][slot], -1);
+    }
+    if (wordle_server_disconnect(&game_server, fd, WORDLE_RECONNECT_GRACE_MS > 0)) {
+        int r = room - game_server.rooms;
+        hold_us[r][slot] = now_us() + (int64_t)WORDLE_RECONNECT_GRACE_MS * 1000;
+        hold_token[r][slot] = room->players[slot].token;
+    }
+    if (room != NULL && room->player_count == 0) {
+        first_round_us[room - game_server.rooms] = 0;
+    }
+
+    free(conns[fd]);
+    conns[fd] = NULL;
+    for (int i = 0; i < open_count; i++) {
+        if (open_fds[i] == fd) {
+            open_fds[i] = open_fds[--open_count];
+            break;
+        }
+    }
+    close(fd);
+}
+
+static void accept_conn(int listen_fd)
+{
+    int fd = accept(listen_fd, NULL, NULL);
+    if (fd < 0) {
+        return;
+    }
+    if (fd >= WORDLE_MAX_FDS) {
+        close(fd);
+        return;
+    }
+
+    int one = 1;
+    struct timeval tv = { .tv_sec = SEND_TIMEOUT };
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+    conns[fd] = calloc(1, sizeof(conn_t));
+    if (conns[fd] == NULL) {
+        close(fd);
+        return;
+    }
+    conns[fd]->fd = fd;
+    open_fds[open_count++] = fd;
+}
+
+// Resumed welcome and the seat's snapshot, written straight away like send_resume()
+static void send_resume(conn_t *c, game_state_t *room, int slot)
+{
+    int r = room - game_server.rooms;
+    hold_us[r][slot] = 0;
+    wordle_outq_reset(&outq[r][slot], c->fd);
+
+    wordle_msg_t welcome = { .type = WORDLE_MSG_WELCOME };
+    welcome.welcome.player_index = slot;
+    welcome.welcome.token = room->players[slot].token;
+    welcome.welcome.resumed = true;
+    if (c->binary) {
+        uint8_t bin[WORDLE_BIN_MAX_LEN + WORDLE_BIN_SNAPSHOT_MAX];
+        size_t len = wordle_msg_to_binary(&welcome, bin);
+        len += wordle_snapshot_to_binary(room, slot, bin + len);
+        ws_send_frame(c->fd, WS_OP_BINARY, bin, len, 0);
+        return;
+    }
+#ifdef WORDLE_HAVE_CJSON
+    char *parts[2] = { wordle_msg_to_json(&welcome), wordle_snapshot_to_json(room, slot) };
+    for (int i = 0; i < 2 && parts[i] != NULL; i++) {
+        ws_send_frame(c->fd, WS_OP_TEXT, (uint8_t *)parts[i], strlen(parts[i]), 0);
+    }
+    cJSON_free(parts[0]);
+    cJSON_free(parts[1]);
+#endif
+}
+
+// Upgrade request: seat the player and welcome them, the GET branch of ws_handler
+static bool handle_handshake(conn_t *c)
+{
+    char path[128];
+    int used = ws_server_handshake(c->fd, (const char *)c->rx, c->rx_len, path, sizeof(path));
+    if (used <= 0) {
+        return used == 0;
+    }
+    c->upgraded = true;
+    c->binary = strstr(path, "proto=bin") != NULL;
+    memmove(c->rx, c->rx + used, c->rx_len - (size_t)used);
+    c->rx_len -= (size_t)used;
+
+#ifndef WORDLE_HAVE_CJSON
+    if (!c->binary) {
+        return false;  // No JSON encoder in this build
+    }
+#endif
+
+    int slot;
+    const char *token = strstr(path, "token=");
+    game_state_t *room = NULL;
+    if (token != NULL) {
+        room = wordle_server_resume(&game_server, c->fd, (uint32_t)strtoul(token + 6, NULL, 10), &slot);
+    }
+    if (room != NULL) {
+        send_resume(c, room, slot);
+        return true;
+    }
+
+    // ?len=N asks for a room of that word length, the default when not built
+    const char *len = strstr(path, "len=");
+    const wordle_variant_t *variant = len != NULL ? wordle_variant_get(atoi(len + 4)) : NULL;
+    room = wordle_server_connect(&game_server, c->fd, variant, &slot);
+    if (room == NULL) {
+        return false;
+    }
+    wordle_outq_reset(&outq[room - game_server.rooms][slot], c->fd);
+    wordle_send_welcome(room, slot);
+    return true;
+}
+
+// Read what is there and run every complete frame. False closes the connection.
+static bool handle_readable(conn_t *c)
+{
+    ssize_t n = read(c->fd, c->rx + c->rx_len, CONN_RX_LEN - c->rx_len);
+    if (n <= 0) {
+        return false;
+    }
+    c->rx_len += (size_t)n;
+
+    if (!c->upgraded) {
+        return handle_handshake(c);
+    }
+
+    size_t pos = 0;
+    while (pos < c->rx_len) {
+        ws_frame_t frame;
+        int used = ws_parse_frame(c->rx + pos, c->rx_len - pos, &frame);
+        if (used < 0) {
+            return false;
+        }
+        if (used == 0) {
+            break;
+        }
+        pos += (size_t)used;
+
+        if (frame.opcode == WS_OP_CLOSE) {
+            return false;
+        }
+        if (frame.opcode == WS_OP_TEXT && frame.len < 128) {
+            char text[128];
+            memcpy(text, frame.payload, frame.len);
+            handle_text(c->fd, text, frame.len);
+        }
+    }
+    memmove(c->rx, c->rx + pos, c->rx_len - pos);
+    c->rx_len -= pos;
+    return c->rx_len < CONN_RX_LEN;  // A frame larger than the buffer is not the game talking
+}
+
+// Turn deadlines, delayed first rounds and ends of grace periods that are due,
+// and the poll timeout until the next one
+static int run_timers(void)
+{
+    int64_t now = now_us();
+    int64_t next = -1;
+    for (int r = 0; r < WORDLE_MAX_ROOMS; r++) {
+        if (first_round_us[r] && first_round_us[r] <= now) {
+            first_round_us[r] = 0;
+            wordle_start_first_round(&game_server.rooms[r]);
+        }
+        if (deadline_us[r] && deadline_us[r] <= now) {
+            deadline_us[r] = 0;
+            wordle_handle_deadline(&game_server.rooms[r]);
+        }
+        if (first_round_us[r] && (next < 0 || first_round_us[r] < next)) {
+            next = first_round_us[r];
+        }
+        if (deadline_us[r] && (next < 0 || deadline_us[r] < next)) {
+            next = deadline_us[r];
+        }
+        for (int p = 0; p < WORDLE_MAX_PLAYERS; p++) {
+            if (hold_us[r][p] && hold_us[r][p] <= now) {
+                hold_us[r][p] = 0;
+                wordle_server_release(&game_server, &game_server.rooms[r], p, hold_token[r][p]);
+                if (game_server.rooms[r].player_count == 0) {
+                    first_round_us[r] = 0;
+                }
+            }
+            if (hold_us[r][p] && (next < 0 || hold_us[r][p] < next)) {
+                next = hold_us[r][p];
+            }
+        }
+    }
+    return next < 0 ? -1 : (int)((next - now + 999) / 1000);
+}
+
+int host_server_run(int listen_fd, const host_server_config_t *config)
+{
+    join_delay_ms = config->join_delay_ms;
+    signal(SIGINT, on_signal);
+    signal(SIGTERM, on_signal);
+    signal(SIGPIPE, SIG_IGN);
+
+    wordle_server_init(&game_server, 0, send_to_fd, NULL);
+    wordle_server_set_deadline(&game_server, arm_deadline, NULL);
+    for (int r = 0; r < WORDLE_MAX_ROOMS; r++) {
+        for (int p = 0; p < WORDLE_MAX_PLAYERS; p++) {
+            wordle_outq_reset(&outq[r][p], -1);
+        }
+    }
+    if (config->ready_fd >= 0) {
+        (void)!write(config->ready_fd, "", 1);
+    }
+
+    struct pollfd *fds = malloc(sizeof(struct pollfd) * (WORDLE_MAX_FDS + 1));
+    if (fds == NULL) {
+        return 1;
+    }
+    while (!stop) {
+        int timeout = run_timers();
+        flush_queues();
+
+        fds[0] = (struct pollfd){ .fd = listen_fd, .events = POLLIN };
+        int count = open_count;
+        for (int i = 0; i < count; i++) {
+            fds[i + 1] = (struct pollfd){ .fd = open_fds[i], .events = POLLIN };
+        }
+        int ready = poll(fds, (nfds_t)count + 1, timeout);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        // Each readable socket is one event, answered before the next is read
+        for (int i = 1; i <= count; i++) {
+            if (fds[i].revents == 0) {
+                continue;
+            }
+            int fd = fds[i].fd;
+            if (!(fds[i].revents & POLLIN) || !handle_readable(conns[fd])) {
+                close_conn(fd);
+            }
+            flush_queues();
+        }
+        if (fds[0].revents & POLLIN) {
+            accept_conn(listen_fd);
+        }
+    }
+
+    free(fds);
+    for (int i = open_count - 1; i >= 0; i--) {
+        close_conn(open_fds[i]);
+    }
+    return 0;
+}
@@ -0,0 +1,16 @@
+#ifndef HOST_SERVER_H
+#define HOST_SERVER_H
+
+// The game engine behind POSIX sockets: the device's ws_handler, sender task
+// and turn timers folded into one poll() loop, which is also how httpd runs
+// them (one task for every socket). Serves /ws only.
+
+typedef struct {
+    int join_delay_ms;       // Pause between both players joining and round 1
+    int ready_fd;            // Written once when the server is up, -1 for none
+} host_server_config_t;
+
+// Serve on an already listening socket until SIGINT or SIGTERM
+int host_server_run(int listen_fd, const host_server_config_t *config);
+
+#endif // HOST_SERVER_H
@@ -0,0 +1,586 @@
+// Load generator: many scripted players talking the page's protocol
+// (script.js) to a wordle server, by default a host server it forks itself.
+//
+//   ./wordle_loadgen [-n clients] [-r rounds] [-d join_delay_ms] [-t timeout_s]
+//                    [-R reconnect_pct] [-H host:port]
+//
+// Each client connects to /ws?proto=bin&len=N, joins once welcomed, guesses a
+// random answer word at round start and after every both_guessed, and asks
+// for the next round when one ends, until it has played its rounds. Pairs of
+// clients take turns over the word lengths the engine was built with, so
+// rooms of every length play at once. Latency is from
+// a guess leaving the client to its own result arriving, so it includes the
+// generator's loop; with hundreds of clients on one core that part dominates
+// once the server keeps up. Memory per connection is the forked server's RSS
+// growth over the connect phase, so it is only reported without -H.
+//
+// With -R, that percentage of rounds has one client drop its socket right
+// after a result and reconnect with its session token; the reconnect latency
+// is from connect() to the snapshot that puts it back in the game.
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include "wordle_engine.h"
+#include "wordle_proto.h"
+#include "ws_shim.h"
+#include "host_server.h"
+#include "bench_util.h"
+
+#define CLIENT_RX_LEN  1024
+
+typedef enum {
+    CLIENT_HANDSHAKE,
+    CLIENT_PLAYING,
+    CLIENT_DONE,
+} client_state_t;
+
+typedef struct {
+    int fd;
+    client_state_t state;
+    int player;              // Seat from welcome
+    const wordle_variant_t *variant;  // Length asked for, then the one welcome announces
+    int rounds_done;
+    int round;               // Server's round number
+    int guesses;             // This round
+    bool in_round;
+    bool won;
+    uint64_t guess_sent_ns;  // Outstanding guess, 0 when none
+    uint32_t token;          // Session token from the last welcome
+    bool drop_this_round;    // Reconnect after this round's first result
+    bool drop_now;           // Reconnect after this frame
+    uint64_t reconnect_ns;   // Reconnect in progress, 0 when none
+    uint32_t seed;
+    size_t rx_len;
+    uint8_t rx[CLIENT_RX_LEN];
+} client_t;
+
+static struct {
+    uint64_t frames;
+    uint64_t messages;
+    uint64_t bytes;
+    uint64_t guesses;
+    uint64_t rounds;
+    uint64_t reconnects;
+    uint64_t resume_failures; // Reconnects that got a fresh seat instead
+    uint32_t *latency_us;    // One sample per answered guess
+    size_t latency_count;
+    size_t latency_cap;
+    uint32_t *reconnect_us;  // One sample per resumed session
+    size_t reconnect_count;
+    size_t reconnect_cap;
+} stats;
+
+static int rounds_per_client = 3;
+static int reconnect_pct;
+static struct sockaddr_in server_addr;
+static char host_header[32];
+
+// Message length by binary type at a word length, the table script.js splits
+// frames with. 0 for an unknown type; SNAPSHOT carries its own.
+static size_t bin_len(uint8_t type, int word_len)
+{
+    switch (type) {
+    case WORDLE_BIN_WELCOME: return 9;
+    case WORDLE_BIN_LOBBY_UPDATE: return 2;
+    case WORDLE_BIN_GAME_STARTING: return 1;
+    case WORDLE_BIN_ROUND_START: return 8;
+    case WORDLE_BIN_RESULT: return 2 + WORDLE_BIN_CODE_BYTES(word_len) + WORDLE_BIN_WORD_BYTES(word_len);
+    case WORDLE_BIN_OPPONENT_SUBMITTED: return 4;
+    case WORDLE_BIN_BOTH_GUESSED: return 1;
+    case WORDLE_BIN_ROUND_END: return 6 + WORDLE_BIN_WORD_BYTES(word_len);
+    case WORDLE_BIN_TIMEOUT: return 1;
+    case WORDLE_BIN_INVALID_GUESS: return 1 + word_len;
+    default: return 0;
+    }
+}
+
+static void record_sample(uint32_t **samples, size_t *count, size_t *cap, uint32_t us)
+{
+    if (*count == *cap) {
+        *cap = *cap ? *cap * 2 : 4096;
+        *samples = realloc(*samples, *cap * sizeof(uint32_t));
+    }
+    (*samples)[(*count)++] = us;
+}
+
+static void record_latency(uint32_t us)
+{
+    record_sample(&stats.latency_us, &stats.latency_count, &stats.latency_cap, us);
+}
+
+static uint32_t get_u16(const uint8_t *p)
+{
+    return p[0] | p[1] << 8;
+}
+
+static uint32_t get_u32(const uint8_t *p)
+{
+    return get_u16(p) | get_u16(p + 2) << 16;
+}
+
+static wordle_fb_t get_code(const uint8_t *p, int word_len)
+{
+    return WORDLE_BIN_CODE_BYTES(word_len) == 1 ? p[0] : get_u16(p);
+}
+
+// Open a connection and send the upgrade request, with the session token when
+// taking a held seat back. False on failure, errno says why.
+static bool client_connect(client_t *c, uint32_t token)
+{
+    char path[48];
+    int one = 1;
+    int n = snprintf(path, sizeof(path), "/ws?proto=bin&len=%d", c->variant->word_len);
+    if (token) {
+        snprintf(path + n, sizeof(path) - n, "&token=%u", token);
+    }
+    c->fd = socket(AF_INET, SOCK_STREAM, 0);
+    c->state = CLIENT_HANDSHAKE;
+    c->rx_len = 0;
+    setsockopt(c->fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    return c->fd >= 0 && connect(c->fd, (struct sockaddr *)&server_addr, sizeof(server_addr)) == 0 &&
+           ws_client_request(c->fd, host_header, path) == 0;
+}
+
+static int send_text(client_t *c, const char *text)
+{
+    char buf[96];
+    size_t len = strlen(text);
+    memcpy(buf, text, len);
+    c->seed = c->seed * 1664525u + 1013904223u;
+    return ws_send_frame(c->fd, WS_OP_TEXT, (uint8_t *)buf, len, c->seed | 1);
+}
+
+static void send_guess(client_t *c)
+{
+    char msg[64];
+    char word[WORDLE_MAX_WORD_LEN + 1];
+    c->seed = c->seed * 1664525u + 1013904223u;
+    c->variant->unpack(c->variant->answers[(c->seed >> 8) % c->variant->answer_count], word);
+    snprintf(msg, sizeof(msg), "{\"type\":\"guess\",\"word\":\"%s\"}", word);
+    c->guess_sent_ns = bench_now_ns();
+    stats.guesses++;
+    send_text(c, msg);
+}
+
+// One frame from the server: apply every message, then act once, the way a
+// player reacts to what is on screen after the frame is drawn
+static void handle_frame(client_t *c, const uint8_t *p, size_t len)
+{
+    bool want_guess = false;
+    bool want_next = false;
+    stats.frames++;
+    stats.bytes += len;
+
+    for (size_t pos = 0; pos < len; ) {
+        uint8_t type = p[pos];
+        size_t msg_len = type == WORDLE_BIN_SNAPSHOT && pos + 1 < len ? 2u + p[pos + 1]
+                       : bin_len(type, c->variant->word_len);
+        if (msg_len == 0 || pos + msg_len > len) {
+            fprintf(stderr, "client %d: bad message type 0x%02x\n", c->fd, type);
+            c->state = CLIENT_DONE;
+            return;
+        }
+        const uint8_t *m = p + pos;
+        pos += msg_len;
+        stats.messages++;
+
+        switch (type) {
+        case WORDLE_BIN_WELCOME: {
+            char msg[48];
+            c->player = m[1];
+            c->token = get_u32(m + 2);
+            if (m[7] != c->variant->word_len) {
+                fprintf(stderr, "client %d: asked for %d letters, seated at %d\n", c->fd,
+                        c->variant->word_len, m[7]);
+                c->state = CLIENT_DONE;
+                return;
+            }
+            if (m[6]) {
+                break;  // Resumed, the snapshot follows
+            }
+            if (c->reconnect_ns) {
+                // The seat was gone: count it and stop rather than join a new room
+                stats.resume_failures++;
+                c->state = CLIENT_DONE;
+                return;
+            }
+            snprintf(msg, sizeof(msg), "{\"type\":\"join\",\"name\":\"bot%d\"}", c->fd);
+            send_text(c, msg);
+            break;
+        }
+        case WORDLE_BIN_SNAPSHOT: {
+            // Pick up where the board says: rows, whether this turn is played
+            // already, or the round_end that was missed
+            uint8_t flags = m[8];
+            const uint8_t *seat = m + 15;
+            const int word_len = c->variant->word_len;
+            const int row_bytes = WORDLE_BIN_CODE_BYTES(word_len) + WORDLE_BIN_WORD_BYTES(word_len);
+            int used[WORDLE_MAX_PLAYERS];
+            for (int i = 0; i < WORDLE_MAX_PLAYERS; i++) {
+                used[i] = seat[0];
+                if (i == c->player) {
+                    c->guesses = seat[0];
+                    c->won = false;
+                    for (int r = 0; r < seat[1]; r++) {
+                        c->won |= get_code(seat + 2 + r * row_bytes, word_len) == c->variant->all_green;
+                    }
+                }
+                seat += 2 + seat[1] * row_bytes;
+            }
+            if (c->reconnect_ns) {
+                record_sample(&stats.reconnect_us, &stats.reconnect_count, &stats.reconnect_cap,
+                              (uint32_t)((bench_now_ns() - c->reconnect_ns) / 1000));
+                c->reconnect_ns = 0;
+            }
+            c->guess_sent_ns = 0;
+
+            // The round ended while away, and maybe the opponent started the next
+            int round = (int)get_u16(m + 2);
+            bool over = (flags & 2) != 0;
+            if (c->in_round && (over || round != c->round)) {
+                c->in_round = false;
+                c->rounds_done++;
+                stats.rounds++;
+                want_next = over;
+            }
+            if (round != c->round && !over) {
+                c->round = round;
+                c->in_round = c->rounds_done < rounds_per_client;
+            }
+            if (c->in_round && used[c->player] <= used[!c->player]) {
+                want_guess = true;
+            }
+            break;
+        }
+        case WORDLE_BIN_ROUND_START:
+            c->round = (int)get_u16(m + 1);
+            c->in_round = true;
+            c->seed = c->seed * 1664525u + 1013904223u;
+            c->drop_this_round = (int)((c->seed >> 8) % 100) < reconnect_pct;
+            c->won = false;
+            c->guesses = 0;
+            want_guess = true;
+            break;
+        case WORDLE_BIN_RESULT:
+            if (m[1] == c->player) {
+                if (c->guess_sent_ns) {
+                    record_latency((uint32_t)((bench_now_ns() - c->guess_sent_ns) / 1000));
+                    c->guess_sent_ns = 0;
+                }
+                c->guesses++;
+                c->won = (get_code(m + 2, c->variant->word_len) == c->variant->all_green);
+                c->drop_now = c->drop_this_round && !c->won;
+                c->drop_this_round = false;
+            }
+            break;
+        case WORDLE_BIN_TIMEOUT:
+            c->guesses++;
+            break;
+        case WORDLE_BIN_INVALID_GUESS:
+            c->guess_sent_ns = 0;
+            want_guess = true;
+            break;
+        case WORDLE_BIN_BOTH_GUESSED:
+            want_guess = true;
+            break;
+        case WORDLE_BIN_ROUND_END:
+            c->in_round = false;
+            c->rounds_done++;
+            stats.rounds++;
+            want_next = true;
+            break;
+        default:
+            break;
+        }
+    }
+
+    if (c->drop_now && !want_next) {
+        return;  // The socket goes away before acting on this frame
+    }
+    c->drop_now = false;
+    if (want_next) {
+        if (c->rounds_done >= rounds_per_client) {
+            c->state = CLIENT_DONE;
+        } else {
+            send_text(c, "{\"type\":\"next_round\"}");
+        }
+    } else if (want_guess && c->in_round && !c->won && c->guesses < c->variant->max_guesses) {
+        send_guess(c);
+    }
+}
+
+// Read and handle what arrived. False when the connection is finished.
+static bool client_readable(client_t *c)
+{
+    ssize_t n = read(c->fd, c->rx + c->rx_len, CLIENT_RX_LEN - c->rx_len);
+    if (n <= 0) {
+        return false;
+    }
+    c->rx_len += (size_t)n;
+
+    size_t pos = 0;
+    if (c->state == CLIENT_HANDSHAKE) {
+        int used = ws_client_response((const char *)c->rx, c->rx_len);
+        if (used < 0) {
+            return false;
+        }
+        if (used == 0) {
+            return true;
+        }
+        c->state = CLIENT_PLAYING;
+        pos = (size_t)used;
+    }
+
+    while (pos < c->rx_len && c->state == CLIENT_PLAYING) {
+        ws_frame_t frame;
+        int used = ws_parse_frame(c->rx + pos, c->rx_len - pos, &frame);
+        if (used < 0) {
+            return false;
+        }
+        if (used == 0) {
+            break;
+        }
+        pos += (size_t)used;
+        if (frame.opcode == WS_OP_CLOSE) {
+            return false;
+        }
+        if (frame.opcode == WS_OP_BINARY) {
+            handle_frame(c, frame.payload, frame.len);
+        }
+        if (c->drop_now) {
+            // Drop mid-round and come straight back with the token
+            c->drop_now = false;
+            close(c->fd);
+            stats.reconnects++;
+            c->reconnect_ns = bench_now_ns();
+            return client_connect(c, c->token);
+        }
+    }
+    memmove(c->rx, c->rx + pos, c->rx_len - pos);
+    c->rx_len -= pos;
+    return c->state != CLIENT_DONE;
+}
+
+// Resident set of a process in bytes
+static long rss_bytes(pid_t pid)
+{
+    char path[64];
+    long pages = 0;
+    snprintf(path, sizeof(path), "/proc/%d/statm", (int)pid);
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        return 0;
+    }
+    if (fscanf(f, "%*d %ld", &pages) != 1) {
+        pages = 0;
+    }
+    fclose(f);
+    return pages * sysconf(_SC_PAGESIZE);
+}
+
+static int compare_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static uint32_t percentile(const uint32_t *sorted, size_t count, double p)
+{
+    if (count == 0) {
+        return 0;
+    }
+    size_t i = (size_t)(p * (double)(count - 1) + 0.5);
+    return sorted[i];
+}
+
+static void usage(const char *argv0)
+{
+    fprintf(stderr, "usage: %s [-n clients] [-r rounds] [-d join_delay_ms] [-t timeout_s] "
+                    "[-R reconnect_pct] [-H host:port]\n", argv0);
+}
+
+int main(int argc, char **argv)
+{
+    int clients = 200;
+    int join_delay_ms = 1000;
+    int timeout_s = 120;
+    const char *target = NULL;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:r:d:t:R:H:")) != -1) {
+        switch (opt) {
+        case 'n': clients = atoi(optarg); break;
+        case 'r': rounds_per_client = atoi(optarg); break;
+        case 'd': join_delay_ms = atoi(optarg); break;
+        case 't': timeout_s = atoi(optarg); break;
+        case 'R': reconnect_pct = atoi(optarg); break;
+        case 'H': target = optarg; break;
+        default: usage(argv[0]); return 2;
+        }
+    }
+    if (clients < 1 || rounds_per_client < 1) {
+        usage(argv[0]);
+        return 2;
+    }
+    signal(SIGPIPE, SIG_IGN);
+
+    // Both ends hold one fd per client
+    struct rlimit lim;
+    if (getrlimit(RLIMIT_NOFILE, &lim) == 0 && lim.rlim_cur < lim.rlim_max) {
+        lim.rlim_cur = lim.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &lim);
+    }
+
+    server_addr.sin_family = AF_INET;
+    pid_t server_pid = 0;
+    if (target != NULL) {
+        char host[64];
+        int port;
+        if (sscanf(target, "%63[^:]:%d", host, &port) != 2 || inet_pton(AF_INET, host, &server_addr.sin_addr) != 1) {
+            usage(argv[0]);
+            return 2;
+        }
+        server_addr.sin_port = htons((uint16_t)port);
+    } else {
+        // Listen before forking so the clients never race the server's startup
+        int listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+        socklen_t addr_len = sizeof(server_addr);
+        server_addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (bind(listen_fd, (struct sockaddr *)&server_addr, sizeof(server_addr)) != 0 ||
+            listen(listen_fd, 1024) != 0 ||
+            getsockname(listen_fd, (struct sockaddr *)&server_addr, &addr_len) != 0) {
+            perror("listen");
+            return 1;
+        }
+
+        int ready[2];
+        if (pipe(ready) != 0) {
+            perror("pipe");
+            return 1;
+        }
+        server_pid = fork();
+        if (server_pid == 0) {
+            close(ready[0]);
+            host_server_config_t config = { .join_delay_ms = join_delay_ms, .ready_fd = ready[1] };
+            _exit(host_server_run(listen_fd, &config));
+        }
+        close(ready[1]);
+        close(listen_fd);
+        char byte;
+        if (server_pid < 0 || read(ready[0], &byte, 1) != 1) {
+            fprintf(stderr, "server did not start\n");
+            return 1;
+        }
+        close(ready[0]);
+    }
+    snprintf(host_header, sizeof(host_header), "%s:%d", inet_ntoa(server_addr.sin_addr), ntohs(server_addr.sin_port));
+
+    long rss_idle = server_pid ? rss_bytes(server_pid) : 0;
+
+    client_t *c = calloc((size_t)clients, sizeof(client_t));
+    struct pollfd *fds = calloc((size_t)clients, sizeof(struct pollfd));
+    if (c == NULL || fds == NULL) {
+        return 1;
+    }
+
+    // Connect phase: everyone in, handshakes answered, seated and welcomed
+    uint64_t start = bench_now_ns();
+    for (int i = 0; i < clients; i++) {
+        c[i].seed = 0x9E3779B9u * (uint32_t)(i + 1);
+        c[i].variant = wordle_variants[(i / WORDLE_MAX_PLAYERS) % WORDLE_VARIANT_COUNT];
+        if (!client_connect(&c[i], 0)) {
+            fprintf(stderr, "client %d: %s\n", i, strerror(errno));
+            return 1;
+        }
+    }
+
+    int active = clients;
+    bool connected = false;
+    uint64_t connect_ns = 0;
+    long rss_connected = 0;
+    uint64_t deadline = start + (uint64_t)timeout_s * 1000000000ull;
+    while (active > 0 && bench_now_ns() < deadline) {
+        for (int i = 0; i < clients; i++) {
+            fds[i] = (struct pollfd){ .fd = c[i].state == CLIENT_DONE ? -1 : c[i].fd, .events = POLLIN };
+        }
+        if (poll(fds, (nfds_t)clients, 100) < 0 && errno != EINTR) {
+            break;
+        }
+        for (int i = 0; i < clients; i++) {
+            if (fds[i].revents && !client_readable(&c[i])) {
+                c[i].state = CLIENT_DONE;
+                close(c[i].fd);
+                active--;
+            }
+        }
+
+        // Everyone seated: the server now holds all connections at once
+        if (!connected) {
+            int playing = 0;
+            for (int i = 0; i < clients; i++) {
+                playing += (c[i].state != CLIENT_HANDSHAKE);
+            }
+            if (playing == clients) {
+                connected = true;
+                connect_ns = bench_now_ns() - start;
+                rss_connected = server_pid ? rss_bytes(server_pid) : 0;
+            }
+        }
+    }
+    uint64_t elapsed = bench_now_ns() - start;
+
+    if (server_pid > 0) {
+        kill(server_pid, SIGTERM);
+        waitpid(server_pid, NULL, 0);
+    }
+
+    qsort(stats.latency_us, stats.latency_count, sizeof(uint32_t), compare_u32);
+    double seconds = (double)elapsed / 1e9;
+    printf("%-36s %12d clients, %d rounds each, against %s%s\n", "load", clients, rounds_per_client,
+           host_header, target ? "" : " (forked host server)");
+    printf("%-36s %12.1f ms%s\n", "connect phase", connect_ns / 1e6, connected ? "" : " (not all connected)");
+    printf("%-36s %12.1f s%s\n", "run", seconds, active ? " (timed out)" : "");
+    printf("%-36s %12llu rounds %10.1f /s\n", "rounds completed", (unsigned long long)stats.rounds / 2,
+           stats.rounds / 2 / seconds);
+    printf("%-36s %12llu guesses %9.1f /s\n", "guesses sent", (unsigned long long)stats.guesses,
+           stats.guesses / seconds);
+    printf("%-36s %12llu frames %10.1f /s\n", "frames received", (unsigned long long)stats.frames,
+           stats.frames / seconds);
+    printf("%-36s %12llu messages %8.1f /s\n", "messages received", (unsigned long long)stats.messages,
+           stats.messages / seconds);
+    printf("%-36s %12llu bytes\n", "payload received", (unsigned long long)stats.bytes);
+    printf("%-36s %12u us p50 %8u us p99 %8u us max\n", "guess -> result latency",
+           percentile(stats.latency_us, stats.latency_count, 0.50),
+           percentile(stats.latency_us, stats.latency_count, 0.99),
+           percentile(stats.latency_us, stats.latency_count, 1.0));
+    if (reconnect_pct) {
+        qsort(stats.reconnect_us, stats.reconnect_count, sizeof(uint32_t), compare_u32);
+        printf("%-36s %12llu resumed %9llu fresh seat\n", "reconnects",
+               (unsigned long long)stats.reconnect_count, (unsigned long long)stats.resume_failures);
+        printf("%-36s %12u us p50 %8u us p99 %8u us max\n", "reconnect -> snapshot latency",
+               percentile(stats.reconnect_us, stats.reconnect_count, 0.50),
+               percentile(stats.reconnect_us, stats.reconnect_count, 0.99),
+               percentile(stats.reconnect_us, stats.reconnect_count, 1.0));
+    }
+    if (server_pid) {
+        printf("%-36s %12.1f KB idle %8.1f KB connected %6.0f B/connection\n", "server RSS",
+               rss_idle / 1024.0, rss_connected / 1024.0,
+               connected ? (double)(rss_connected - rss_idle) / clients : 0.0);
+    }
+    free(stats.latency_us);
+    free(stats.reconnect_us);
+    free(fds);
+    free(c);
+    return active ? 1 : 0;
+}
@@ -0,0 +1,37 @@
+// Standalone host server, for pointing a browser or the load generator at.
+//
+//   ./wordle_server_host [port] [join_delay_ms]
+//
+// then open the page against it, or run wordle_loadgen -H 127.0.0.1:port.
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "host_server.h"
+
+int main(int argc, char **argv)
+{
+    int port = argc > 1 ? atoi(argv[1]) : 8080;
+    host_server_config_t config = {
+        .join_delay_ms = argc > 2 ? atoi(argv[2]) : 1000,
+        .ready_fd = -1,
+    };
+
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    struct sockaddr_in addr = {
+        .sin_family = AF_INET,
+        .sin_port = htons((uint16_t)port),
+        .sin_addr.s_addr = htonl(INADDR_ANY),
+    };
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, 512) != 0) {
+        perror("listen");
+        return 1;
+    }
+    printf("wordle host server on port %d, ws://127.0.0.1:%d/ws?proto=bin\n", port, port);
+    int ret = host_server_run(fd, &config);
+    close(fd);
+    return ret;
+}
@@ -0,0 +1,298 @@
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include "ws_shim.h"
+
+#define WS_GUID        "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
+#define WS_CLIENT_KEY  "dGhlIHNhbXBsZSBub25jZQ=="   // RFC 6455 sample nonce, fine for a harness
+
+// SHA-1, only ever run over the handshake key
+static uint32_t rol(uint32_t x, int n)
+{
+    return (x << n) | (x >> (32 - n));
+}
+
+static void sha1_block(uint32_t h[5], const uint8_t *p)
+{
+    uint32_t w[80];
+    for (int i = 0; i < 16; i++) {
+        w[i] = (uint32_t)p[4 * i] << 24 | (uint32_t)p[4 * i + 1] << 16 | (uint32_t)p[4 * i + 2] << 8 | p[4 * i + 3];
+    }
+    for (int i = 16; i < 80; i++) {
+        w[i] = rol(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+    }
+
+    uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+    for (int i = 0; i < 80; i++) {
+        uint32_t f, k;
+        if (i < 20) {
+            f = (b & c) | (~b & d);
+            k = 0x5A827999;
+        } else if (i < 40) {
+            f = b ^ c ^ d;
+            k = 0x6ED9EBA1;
+        } else if (i < 60) {
+            f = (b & c) | (b & d) | (c & d);
+            k = 0x8F1BBCDC;
+        } else {
+            f = b ^ c ^ d;
+            k = 0xCA62C1D6;
+        }
+        uint32_t t = rol(a, 5) + f + e + k + w[i];
+        e = d;
+        d = c;
+        c = rol(b, 30);
+        b = a;
+        a = t;
+    }
+    h[0] += a;
+    h[1] += b;
+    h[2] += c;
+    h[3] += d;
+    h[4] += e;
+}
+
+static void sha1(const uint8_t *data, size_t len, uint8_t out[20])
+{
+    uint32_t h[5] = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+    uint8_t block[64];
+    size_t i = 0;
+    for (; i + 64 <= len; i += 64) {
+        sha1_block(h, data + i);
+    }
+
+    // Tail, the 0x80 marker and the bit length, in one or two blocks
+    size_t rest = len - i;
+    memset(block, 0, sizeof(block));
+    memcpy(block, data + i, rest);
+    block[rest] = 0x80;
+    if (rest >= 56) {
+        sha1_block(h, block);
+        memset(block, 0, sizeof(block));
+    }
+    uint64_t bits = (uint64_t)len * 8;
+    for (int b = 0; b < 8; b++) {
+        block[63 - b] = (uint8_t)(bits >> (8 * b));
+    }
+    sha1_block(h, block);
+
+    for (int b = 0; b < 20; b++) {
+        out[b] = (uint8_t)(h[b / 4] >> (24 - 8 * (b % 4)));
+    }
+}
+
+static void base64(const uint8_t *in, size_t len, char *out)
+{
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    size_t o = 0;
+    for (size_t i = 0; i < len; i += 3) {
+        uint32_t v = (uint32_t)in[i] << 16;
+        if (i + 1 < len) v |= (uint32_t)in[i + 1] << 8;
+        if (i + 2 < len) v |= in[i + 2];
+        out[o++] = alphabet[(v >> 18) & 63];
+        out[o++] = alphabet[(v >> 12) & 63];
+        out[o++] = i + 1 < len ? alphabet[(v >> 6) & 63] : '=';
+        out[o++] = i + 2 < len ? alphabet[v & 63] : '=';
+    }
+    out[o] = '\0';
+}
+
+// Sec-WebSocket-Accept for a client key
+static void accept_key(const char *key, size_t key_len, char out[29])
+{
+    char buf[128];
+    uint8_t digest[20];
+    int n = snprintf(buf, sizeof(buf), "%.*s" WS_GUID, (int)key_len, key);
+    sha1((const uint8_t *)buf, (size_t)n, digest);
+    base64(digest, sizeof(digest), out);
+}
+
+// End of the HTTP header block, or NULL when it has not all arrived
+static const char *header_end(const char *buf, size_t len)
+{
+    for (size_t i = 3; i < len; i++) {
+        if (buf[i - 3] == '\r' && buf[i - 2] == '\n' && buf[i - 1] == '\r' && buf[i] == '\n') {
+            return buf + i + 1;
+        }
+    }
+    return NULL;
+}
+
+// Value of a header line, case-insensitive name, NULL if absent
+static const char *header_value(const char *buf, const char *end, const char *name, size_t *value_len)
+{
+    size_t name_len = strlen(name);
+    for (const char *line = buf; line < end; ) {
+        const char *eol = memchr(line, '\n', (size_t)(end - line));
+        if (eol == NULL) {
+            break;
+        }
+        if ((size_t)(eol - line) > name_len && strncasecmp(line, name, name_len) == 0 && line[name_len] == ':') {
+            const char *v = line + name_len + 1;
+            while (*v == ' ') v++;
+            const char *v_end = eol;
+            while (v_end > v && (v_end[-1] == '\r' || v_end[-1] == ' ')) v_end--;
+            *value_len = (size_t)(v_end - v);
+            return v;
+        }
+        line = eol + 1;
+    }
+    return NULL;
+}
+
+static int write_all(int fd, const void *data, size_t len)
+{
+    const uint8_t *p = data;
+    while (len > 0) {
+        ssize_t n = write(fd, p, len);
+        if (n <= 0) {
+            return -1;
+        }
+        p += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+int ws_server_handshake(int fd, const char *req, size_t len, char *path, size_t path_len)
+{
+    const char *end = header_end(req, len);
+    if (end == NULL) {
+        return len > 2048 ? -1 : 0;
+    }
+
+    const char *target = req + 4;
+    const char *target_end = memchr(target, ' ', (size_t)(end - target));
+    size_t key_len;
+    const char *key = header_value(req, end, "Sec-WebSocket-Key", &key_len);
+    if (strncmp(req, "GET ", 4) != 0 || target_end == NULL || key == NULL || key_len > 64) {
+        return -1;
+    }
+    snprintf(path, path_len, "%.*s", (int)(target_end - target), target);
+
+    char accept[29];
+    char resp[160];
+    accept_key(key, key_len, accept);
+    int n = snprintf(resp, sizeof(resp),
+                     "HTTP/1.1 101 Switching Protocols\r\n"
+                     "Upgrade: websocket\r\n"
+                     "Connection: Upgrade\r\n"
+                     "Sec-WebSocket-Accept: %s\r\n\r\n", accept);
+    if (write_all(fd, resp, (size_t)n) != 0) {
+        return -1;
+    }
+    return (int)(end - req);
+}
+
+int ws_client_request(int fd, const char *host, const char *path)
+{
+    char req[256];
+    int n = snprintf(req, sizeof(req),
+                     "GET %s HTTP/1.1\r\n"
+                     "Host: %s\r\n"
+                     "Upgrade: websocket\r\n"
+                     "Connection: Upgrade\r\n"
+                     "Sec-WebSocket-Key: " WS_CLIENT_KEY "\r\n"
+                     "Sec-WebSocket-Version: 13\r\n\r\n", path, host);
+    return write_all(fd, req, (size_t)n);
+}
+
+int ws_client_response(const char *buf, size_t len)
+{
+    const char *end = header_end(buf, len);
+    if (end == NULL) {
+        return len > 2048 ? -1 : 0;
+    }
+
+    char expected[29];
+    size_t accept_len;
+    const char *accept = header_value(buf, end, "Sec-WebSocket-Accept", &accept_len);
+    accept_key(WS_CLIENT_KEY, strlen(WS_CLIENT_KEY), expected);
+    if (strncmp(buf, "HTTP/1.1 101", 12) != 0 || accept == NULL ||
+        accept_len != strlen(expected) || memcmp(accept, expected, accept_len) != 0) {
+        return -1;
+    }
+    return (int)(end - buf);
+}
+
+int ws_parse_frame(uint8_t *buf, size_t len, ws_frame_t *frame)
+{
+    if (len < 2) {
+        return 0;
+    }
+    if ((buf[0] & 0x80) == 0 || (buf[0] & 0x70) != 0) {
+        return -1;  // Fragmented or extension bits: never sent by the game
+    }
+
+    bool masked = buf[1] & 0x80;
+    size_t payload_len = buf[1] & 0x7F;
+    size_t pos = 2;
+    if (payload_len == 126) {
+        if (len < 4) {
+            return 0;
+        }
+        payload_len = (size_t)buf[2] << 8 | buf[3];
+        pos = 4;
+    } else if (payload_len == 127) {
+        return -1;
+    }
+
+    uint8_t mask[4] = {0};
+    if (masked) {
+        if (len < pos + 4) {
+            return 0;
+        }
+        memcpy(mask, buf + pos, 4);
+        pos += 4;
+    }
+    if (len < pos + payload_len) {
+        return 0;
+    }
+
+    frame->opcode = buf[0] & 0x0F;
+    frame->payload = buf + pos;
+    frame->len = payload_len;
+    if (masked) {
+        for (size_t i = 0; i < payload_len; i++) {
+            frame->payload[i] ^= mask[i & 3];
+        }
+    }
+    return (int)(pos + payload_len);
+}
+
+int ws_send_frame(int fd, uint8_t opcode, uint8_t *payload, size_t len, uint32_t mask)
+{
+    uint8_t hdr[WS_MAX_HEADER];
+    size_t pos = 0;
+    hdr[pos++] = 0x80 | opcode;
+    uint8_t mask_bit = mask ? 0x80 : 0;
+    if (len < 126) {
+        hdr[pos++] = mask_bit | (uint8_t)len;
+    } else {
+        hdr[pos++] = mask_bit | 126;
+        hdr[pos++] = (uint8_t)(len >> 8);
+        hdr[pos++] = (uint8_t)len;
+    }
+    if (mask) {
+        uint8_t key[4] = { (uint8_t)(mask >> 24), (uint8_t)(mask >> 16), (uint8_t)(mask >> 8), (uint8_t)mask };
+        memcpy(hdr + pos, key, 4);
+        pos += 4;
+        for (size_t i = 0; i < len; i++) {
+            payload[i] ^= key[i & 3];
+        }
+    }
+
+    // One writev so header and payload leave in the same segment
+    struct iovec iov[2] = { { hdr, pos }, { payload, len } };
+    size_t total = pos + len;
+    ssize_t n = writev(fd, iov, len ? 2 : 1);
+    if (n == (ssize_t)total) {
+        return 0;
+    }
+    if (n < 0 || (size_t)n < pos) {
+        return -1;
+    }
+    return write_all(fd, payload + (n - pos), total - (size_t)n);
+}
@@ -0,0 +1,43 @@
+#ifndef WS_SHIM_H
+#define WS_SHIM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Minimal RFC 6455 over POSIX sockets for the host harness: the upgrade
+// handshake and framing for the game's small frames, both sides. Not a general
+// WebSocket library: no extensions, no fragmentation, payloads under 64 KB.
+
+#define WS_OP_TEXT    0x1
+#define WS_OP_BINARY  0x2
+#define WS_OP_CLOSE   0x8
+#define WS_OP_PING    0x9
+#define WS_OP_PONG    0xA
+
+#define WS_MAX_HEADER 14
+
+typedef struct {
+    uint8_t opcode;
+    uint8_t *payload;        // Points into the parsed buffer, already unmasked
+    size_t len;
+} ws_frame_t;
+
+// Parse one frame from buf. Returns the bytes it used, 0 when the frame is
+// not complete yet, -1 on something this shim does not speak.
+int ws_parse_frame(uint8_t *buf, size_t len, ws_frame_t *frame);
+
+// Write one frame. Clients pass a non-zero mask, which masks payload in place.
+int ws_send_frame(int fd, uint8_t opcode, uint8_t *payload, size_t len, uint32_t mask);
+
+// Server side: answer an upgrade request in req. Returns the bytes used, 0
+// when the request is not complete yet, -1 when it is not a WebSocket upgrade.
+// The request target, query included, is copied to path.
+int ws_server_handshake(int fd, const char *req, size_t len, char *path, size_t path_len);
+
+// Client side: send the upgrade request, then feed what comes back to
+// ws_client_response until it returns non-zero (bytes used, or -1 refused).
+int ws_client_request(int fd, const char *host, const char *path);
+int ws_client_response(const char *buf, size_t len);
+
+#endif // WS_SHIM_H
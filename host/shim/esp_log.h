@@ -0,0 +1,21 @@
+#ifndef HOST_SHIM_ESP_LOG_H
+#define HOST_SHIM_ESP_LOG_H
+
+// Host stand-in for esp_log.h. Silent by default so benchmarks measure the
+// engine and not stdio; configure with -DWORDLE_HOST_LOG=ON to see the logs.
+#include <stdio.h>
+
+#ifdef WORDLE_HOST_LOG
+#define ESP_LOG_HOST(level, tag, format, ...) \
+    fprintf(stderr, level " (%s): " format "\n", tag, ##__VA_ARGS__)
+#else
+#define ESP_LOG_HOST(level, tag, format, ...) \
+    do { (void)(tag); if (0) { (void)printf(format, ##__VA_ARGS__); } } while (0)
+#endif
+
+#define ESP_LOGE(tag, format, ...) ESP_LOG_HOST("E", tag, format, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) ESP_LOG_HOST("W", tag, format, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...) ESP_LOG_HOST("I", tag, format, ##__VA_ARGS__)
+#define ESP_LOGD(tag, format, ...) ESP_LOG_HOST("D", tag, format, ##__VA_ARGS__)
+
+#endif // HOST_SHIM_ESP_LOG_H
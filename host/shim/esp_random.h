@@ -0,0 +1,18 @@
+#ifndef HOST_SHIM_ESP_RANDOM_H
+#define HOST_SHIM_ESP_RANDOM_H
+
+// Host stand-in for esp_random.h: the kernel's RNG instead of the hardware one
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/random.h>
+
+static inline uint32_t esp_random(void)
+{
+    uint32_t value = 0;
+    if (getrandom(&value, sizeof(value), 0) != sizeof(value)) {
+        value = (uint32_t)random();
+    }
+    return value;
+}
+
+#endif // HOST_SHIM_ESP_RANDOM_H
@@ -1,42 +1,277 @@
 // ======================= Websocket Code =========================
 
-// Get the ESP32's IP address (it's always 192.168.4.1 for the access point)
-const ws = new WebSocket('ws://192.168.4.1/ws');
-
+// Get the ESP32's IP address (it's always 192.168.4.1 for the access point).
+// The server speaks a compact binary protocol by default; add ?json to the
+// page URL to get the readable JSON frames instead when debugging.
+const params = new URLSearchParams(location.search);
+const useBinary = !params.has('json');
+// ?watch=N opens a read-only view of room N instead of joining a game
+const watchRoom = params.get('watch');
+// ?len=N asks for a room of N-letter words, when the server has them
+const wordLength = params.get('len');
+
+// Session token from the last welcome, kept per tab: after a reload or a
+// dropped connection the page hands it back and the server, if it still holds
+// the seat, answers with a snapshot of the game instead of a new seat
+let sessionToken = sessionStorage.getItem('wordleToken');
+let ws = null;
 let wsReady = false;
+let resuming = false;       // Connected with a token, welcome not seen yet
+let reconnectDelay = 500;   // ms, doubled per attempt up to 8 s
+
+function socketUrl() {
+    const query = [];
+    if (useBinary) query.push('proto=bin');
+    if (watchRoom !== null) {
+        query.push('watch=' + encodeURIComponent(watchRoom));
+    } else {
+        if (wordLength !== null) query.push('len=' + encodeURIComponent(wordLength));
+        if (sessionToken) query.push('token=' + sessionToken);
+    }
+    return 'ws://192.168.4.1/ws' + (query.length ? '?' + query.join('&') : '');
+}
 
-ws.onopen = function() {
+function connect() {
+    resuming = watchRoom === null && !!sessionToken;
+    ws = new WebSocket(socketUrl());
+    ws.binaryType = 'arraybuffer';
+    ws.onopen = onSocketOpen;
+    ws.onerror = onSocketError;
+    ws.onclose = onSocketClose;
+    ws.onmessage = onSocketMessage;
+}
+
+function onSocketOpen() {
     console.log('WebSocket connected!');
     wsReady = true;
+    reconnectDelay = 500;
     // Enable the join button
     const joinBtn = document.getElementById("joinBtn");
     if (joinBtn) {
         joinBtn.disabled = false;
         joinBtn.innerText = "Join Game";
     }
-};
+    const botBtn = document.getElementById("botBtn");
+    if (botBtn) {
+        botBtn.disabled = false;
+    }
+}
 
-ws.onerror = function(error) {
+function onSocketError(error) {
     console.log('WebSocket error:', error);
     const joinBtn = document.getElementById("joinBtn");
     if (joinBtn) {
-        joinBtn.innerText = "Connection Failed - Refresh Page";
+        joinBtn.innerText = "Connection Failed - Retrying...";
     }
-};
+}
 
-ws.onclose = function(event) {
-    console.log('WebSocket closed');
+// Retry with exponential backoff, jittered so both phones coming back from
+// the same Wi-Fi hiccup don't retry in lockstep
+function onSocketClose() {
     wsReady = false;
-};
+    const delay = reconnectDelay * (0.5 + Math.random() / 2);
+    reconnectDelay = Math.min(reconnectDelay * 2, 8000);
+    console.log(`WebSocket closed, reconnecting in ${Math.round(delay)} ms`);
+    const status = document.getElementById(watchRoom !== null ? "watchStatus" : "gameStatus");
+    status.innerText = "Connection lost, reconnecting...";
+    setTimeout(connect, delay);
+}
+
+connect();
+
+// Bytes of a packed word and of a feedback code on the wire for words of
+// wordLen letters, see wordle_proto.h
+function wordBytes(wordLen) {
+    return Math.ceil(5 * wordLen / 8);
+}
+
+function codeBytes(wordLen) {
+    return 3 ** wordLen > 256 ? 2 : 1;
+}
+
+// Packed word from the binary protocol: 5 bits per letter, first letter
+// lowest. Seven letters are 35 bits, past JavaScript's 32-bit operators, so
+// this sticks to plain arithmetic.
+function unpackWord(v, offset) {
+    let packed = 0;
+    for (let i = wordBytes(WORD_LEN) - 1; i >= 0; i--) {
+        packed = packed * 256 + v.getUint8(offset + i);
+    }
+    let word = '';
+    for (let i = 0; i < WORD_LEN; i++) {
+        word += String.fromCharCode(65 + packed % 32);
+        packed = Math.floor(packed / 32);
+    }
+    return word;
+}
+
+function getCode(v, offset) {
+    return codeBytes(WORD_LEN) === 1 ? v.getUint8(offset) : v.getUint16(offset, true);
+}
+
+// Feedback code (base 3, first letter lowest) to 0/1/2 per letter
+function expandCode(code) {
+    const result = [];
+    for (let i = 0; i < WORD_LEN; i++) {
+        result.push(code % 3);
+        code = Math.floor(code / 3);
+    }
+    return result;
+}
+
+// Length of each binary message by type byte, see wordle_proto.h; set by
+// setVariant(). The snapshot (0x0B) carries its own length in its second byte.
+let BINARY_LENGTHS = {};
+const BINARY_SNAPSHOT = 0x0B;
+
+// Decode the binary message at offset into the same object the JSON protocol
+// would have sent. Returns { data, length }, length 0 for an unknown type.
+function decodeBinary(buf, offset) {
+    const view = new DataView(buf, offset);
+    const type = view.getUint8(0);
+    let length = BINARY_LENGTHS[type] || 0;
+    if (type === BINARY_SNAPSHOT && view.byteLength > 1) {
+        length = 2 + view.getUint8(1);
+    }
+    if (length === 0 || offset + length > buf.byteLength) {
+        return { data: null, length: 0 };
+    }
+    return { data: decodeBinaryMessage(new DataView(buf, offset, length)), length: length };
+}
+
+function decodeBinaryMessage(v) {
+    switch (v.getUint8(0)) {
+        case 0x01: return { type: 'welcome', player_index: v.getUint8(1),
+                             token: v.getUint32(2, true), resumed: v.getUint8(6) !== 0,
+                             word_length: v.getUint8(7), max_guesses: v.getUint8(8) };
+        case 0x02: return { type: 'lobby_update', player_count: v.getUint8(1) };
+        case 0x03: return { type: 'game_starting' };
+        case 0x04: {
+            const msg = { type: 'round_start', round: v.getUint16(1, true), time_limit: v.getUint8(3) };
+            const hintPlayer = v.getInt8(4);
+            if (hintPlayer >= 0) {
+                msg.hint_player = hintPlayer;
+                msg.hint_position = v.getUint8(5);
+                msg.hint_letter = String.fromCharCode(v.getUint8(6));
+                msg.hint_type = v.getUint8(7) ? 'green' : 'yellow';
+            }
+            return msg;
+        }
+        case 0x05: {
+            const code = getCode(v, 2);
+            return {
+                type: 'result',
+                player: v.getUint8(1),
+                word: unpackWord(v, 2 + codeBytes(WORD_LEN)),
+                result: expandCode(code),
+                is_correct: code === 3 ** WORD_LEN - 1
+            };
+        }
+        case 0x06: return { type: 'opponent_submitted', opponent: v.getUint8(1),
+                             remaining: v.getUint16(2, true) };
+        case 0x07: return { type: 'both_guessed' };
+        case 0x08: return {
+            type: 'round_end',
+            winner: v.getInt8(1),
+            player1_score: v.getUint16(2, true),
+            player2_score: v.getUint16(4, true),
+            target_word: unpackWord(v, 6)
+        };
+        case 0x09: return { type: 'timeout' };
+        case 0x0A: return {
+            type: 'invalid_guess',
+            word: new TextDecoder().decode(new Uint8Array(v.buffer, v.byteOffset + 1, WORD_LEN)).replace(/\0+$/, '')
+        };
+        case 0x0B: {
+            const msg = {
+                type: 'snapshot',
+                round: v.getUint16(2, true),
+                scores: [v.getUint16(4, true), v.getUint16(6, true)],
+                active: (v.getUint8(8) & 1) !== 0,
+                round_over: (v.getUint8(8) & 2) !== 0,
+                hint_player: v.getInt8(9),
+                word_length: v.getUint8(13),
+                max_guesses: v.getUint8(14),
+                players: []
+            };
+            setVariant(msg.word_length, msg.max_guesses);  // The rows below are sized by it
+            if (msg.hint_player >= 0) {
+                msg.hint_position = v.getUint8(10);
+                msg.hint_letter = String.fromCharCode(v.getUint8(11));
+                msg.hint_type = v.getUint8(12) ? 'green' : 'yellow';
+            }
+            const code = codeBytes(WORD_LEN);
+            let o = 15;
+            for (let p = 0; p < 2; p++) {
+                const player = { guesses_used: v.getUint8(o), rows: [] };
+                const rows = v.getUint8(o + 1);
+                o += 2;
+                for (let r = 0; r < rows; r++, o += code + wordBytes(WORD_LEN)) {
+                    player.rows.push({ word: unpackWord(v, o + code),
+                                       result: expandCode(getCode(v, o)) });
+                }
+                msg.players.push(player);
+            }
+            return msg;
+        }
+    }
+    return { type: 'unknown' };
+}
+
+// The server coalesces the messages of one game event into a single frame:
+// back-to-back binary messages, or a JSON array of message objects
+function onSocketMessage(event) {
+    if (event.data instanceof ArrayBuffer) {
+        for (let offset = 0; offset < event.data.byteLength; ) {
+            const msg = decodeBinary(event.data, offset);
+            if (msg.length === 0) {
+                console.log('Unknown binary message at', offset);
+                break;
+            }
+            handleMessage(msg.data);
+            offset += msg.length;
+        }
+        return;
+    }
 
-ws.onmessage = function(event) {
+    let data;
     try {
-        // CHANGE 1 & 2: Added JSON.parse and proper try block wrapping
-        const data = JSON.parse(event.data);
+        data = JSON.parse(event.data);
+    } catch (e) {
+        console.log('Plain message:', event.data);
+        if (event.data.includes("You are Player")) {
+            if (event.data.includes("Player 1")) {
+                playerIndex = 0;
+            } else if (event.data.includes("Player 2")) {
+                playerIndex = 1;
+            }
+            console.log('I am player index:', playerIndex);
+        }
+        return;
+    }
+    (Array.isArray(data) ? data : [data]).forEach(handleMessage);
+}
 
-        if (data.type === 'welcome') {
+function handleMessage(data) {
+    try {
+        if (data.word_length) {
+            setVariant(data.word_length, data.max_guesses);
+        }
+        if (watchRoom !== null) {
+            handleWatchMessage(data);
+        }
+        else if (data.type === 'welcome') {
             playerIndex = data.player_index;
             console.log('I am player index:', playerIndex);
+            sessionToken = String(data.token);
+            sessionStorage.setItem('wordleToken', sessionToken);
+            if (resuming && !data.resumed) {
+                seatLost();
+            }
+            resuming = false;
+        }
+        else if (data.type === 'snapshot') {
+            restoreSnapshot(data);
         }
         else if (data.type === 'lobby_update') {
             // ADD THIS HANDLER
@@ -70,7 +305,9 @@ ws.onmessage = function(event) {
           renderBoard();
           updateScoreDisplay();
 
-          statusEl.innerText = `Round ${roundNumber} - Guess 1/5${getHintText()}`;
+          turnTime = data.time_limit || turnTime;
+          startTimer();
+          statusEl.innerText = `Round ${roundNumber} - Guess 1/${MAX_ROWS} - Time: ${timeRemaining}s${getHintText()}`;
           inputEl.focus();
         }
         else if (data.type === 'result') {
@@ -85,7 +322,7 @@ ws.onmessage = function(event) {
                     return 'absent';
                 });
 
-                for (let c = 0; c < 5; c++) {
+                for (let c = 0; c < WORD_LEN; c++) {
                     boardState[currentRow][c] = data.word[c];
                 }
                 lockedRows[currentRow] = true;
@@ -96,22 +333,22 @@ ws.onmessage = function(event) {
                 if (data.is_correct) {
                     statusEl.innerText = `You got it! Waiting for round to end...`;
                     gameOver = true;
-                    // stopTimer();
+                    stopTimer();
                 } else {
                     waitingForOpponent = true;
                     statusEl.innerText = "Waiting for opponent to guess...";
-                    // stopTimer();
+                    stopTimer();
                 }
             } else {
                 // Opponent's guess
                 if (data.is_correct) {
-                    // statusEl.innerText = `Opponent guessed it! You have ${timeRemaining}s left`;
-                    statusEl.innerText = `Waiting for opponent to guess...${getHintText()}`;
+                    statusEl.innerText = `Opponent guessed it! You have ${timeRemaining}s left${getHintText()}`;
                 }
             }
         }
         else if (data.type === 'round_end') {
           console.log('Round ended. Winner:', data.winner);
+          stopTimer();
           roundActive = false;
           gameOver = true;
 
@@ -136,12 +373,19 @@ ws.onmessage = function(event) {
           restartBtn.innerText = "Next Round";
           restartBtn.style.display = "inline-block";
       }
+        else if (data.type === 'invalid_guess') {
+            // Server rejected the word, the turn is not used - let them edit it
+            inputEl.value = data.word;
+            inputEl.dispatchEvent(new Event('input'));
+            statusEl.innerText = `"${data.word}" is not in the word list${getHintText()}`;
+            inputEl.focus();
+        }
         else if (data.type === 'opponent_submitted') {
             console.log('Opponent submitted');
             opponentWaiting = true;
             if (!waitingForOpponent && !gameOver) {
-                // statusEl.innerText = `Opponent submitted! Your turn - Time: ${timeRemaining}s`;
-                statusEl.innerText = `Opponent submitted! Your turn${getHintText()}`;
+                statusEl.innerText = `Opponent submitted! ${data.remaining} words left for them. ` +
+                                     `Your turn - Time: ${timeRemaining}s${getHintText()}`;
             }
         }
         else if (data.type === 'both_guessed') {
@@ -155,35 +399,34 @@ ws.onmessage = function(event) {
                     statusEl.innerText = "Out of guesses! Waiting for round to end...";
                     gameOver = true;
                 } else {
-                    // startTimer();
-                    // statusEl.innerText = `Guess ${currentRow + 1}/5 - Time: 45s`;
                     updateScoreDisplay();
-                    statusEl.innerText = `Guess ${currentRow + 1}/5${getHintText()}`;
+                    startTimer();
                     inputEl.focus();
                 }
             }
         }
-        // else if (data.type === 'timeout') {
-        //     console.log('Timed out on this guess');
-        //     stopTimer();
-        //     statusEl.innerText = "Time's up! Skipping this guess...";
-        //     waitingForOpponent = true;
-        // }
+        else if (data.type === 'timeout') {
+            // The server skipped this guess: the row stays empty and is used up
+            console.log('Timed out on this guess');
+            stopTimer();
+            boardState[currentRow].fill("");
+            lockedRows[currentRow] = true;
+            inputEl.value = "";
+            renderBoard();
+            statusEl.innerText = "Time's up! Skipping this guess...";
+            waitingForOpponent = true;
+        }
 
     } catch (e) {
-        console.log('Plain message:', event.data);
-        if (event.data.includes("You are Player")) {
-            if (event.data.includes("Player 1")) {
-                playerIndex = 0;
-            } else if (event.data.includes("Player 2")) {
-                playerIndex = 1;
-            }
-            console.log('I am player index:', playerIndex);
-        }
+        console.log('Failed to handle message', data, e);
     }
-};
+}
 
 function sendGuess(word) {
+    if (!wsReady) {
+        statusEl.innerText = "Reconnecting, try again in a moment...";
+        return;
+    }
     const message = {
         type: 'guess',
         word: word.toUpperCase()
@@ -192,19 +435,33 @@ function sendGuess(word) {
 }
 
 /* ---------- Configuration ---------- */
-const MAX_ROWS = 5;
+// Letters per word and rows per round are fixed per server build and
+// announced in welcome and snapshot; until then assume the classic game
+let WORD_LEN = 5;
+let MAX_ROWS = 5;
+
+function setVariant(wordLen, maxRows) {
+    WORD_LEN = wordLen;
+    MAX_ROWS = maxRows;
+    const word = wordBytes(wordLen);
+    BINARY_LENGTHS = { 0x01: 9, 0x02: 2, 0x03: 1, 0x04: 8, 0x05: 2 + codeBytes(wordLen) + word,
+                       0x06: 4, 0x07: 1, 0x08: 6 + word, 0x09: 1, 0x0A: 1 + wordLen };
+    inputEl.maxLength = wordLen;
+    document.documentElement.style.setProperty('--letters', wordLen);
+}
 
 /* ---------- Game State ---------- */
 let playerName = "";
 let playerIndex = -1;
 let currentRow = 0;
-let boardState = Array.from({length: MAX_ROWS}, () => Array(5).fill(""));
-let boardColors = Array.from({length: MAX_ROWS}, () => Array(5).fill(""));  // ADD THIS
+let boardState = Array.from({length: MAX_ROWS}, () => Array(WORD_LEN).fill(""));
+let boardColors = Array.from({length: MAX_ROWS}, () => Array(WORD_LEN).fill(""));  // ADD THIS
 let lockedRows = Array(MAX_ROWS).fill(false);
 let gameOver = false;
 let roundActive = false;
-// let timeRemaining = 45;
-// let timerInterval = null;
+let turnTime = 45;         // Seconds per guess, from round_start
+let timeRemaining = 45;
+let timerInterval = null;
 let myScore = 0;
 let opponentScore = 0;
 let roundNumber = 0;
@@ -221,31 +478,35 @@ const statusEl = document.getElementById("gameStatus");
 const lobbyStatusEl = document.getElementById("lobbyStatus");
 const restartBtn = document.getElementById("restartBtn");
 
+setVariant(WORD_LEN, MAX_ROWS);
+
 /* ------------- Timing --------------- */
-// function updateTimer() {
-//     if (timeRemaining > 0) {
-//         timeRemaining--;
-//         statusEl.innerText = `Time: ${timeRemaining}s`;
-//         if (timeRemaining === 0) {
-//             statusEl.innerText = "Time's up! Waiting for results...";
-//             gameOver = true;
-//         }
-//     }
-// }
-
-// function startTimer() {
-//     if (timerInterval) clearInterval(timerInterval);
-//     timeRemaining = 45;
-//     statusEl.innerText = `Guess ${currentRow + 1}/5 - Time: 45s`;
-//     timerInterval = setInterval(updateTimer, 1000);
-// }
-
-// function stopTimer() {
-//     if (timerInterval) {
-//         clearInterval(timerInterval);
-//         timerInterval = null;
-//     }
-// }
+// Display only: the server owns the deadline and sends 'timeout' when it passes
+function updateTimer() {
+    if (timeRemaining > 0) {
+        timeRemaining--;
+        if (!waitingForOpponent) {
+            statusEl.innerText = `Guess ${currentRow + 1}/${MAX_ROWS} - Time: ${timeRemaining}s${getHintText()}`;
+        }
+        if (timeRemaining === 0) {
+            statusEl.innerText = "Time's up! Waiting for results...";
+        }
+    }
+}
+
+function startTimer() {
+    if (timerInterval) clearInterval(timerInterval);
+    timeRemaining = turnTime;
+    statusEl.innerText = `Guess ${currentRow + 1}/${MAX_ROWS} - Time: ${timeRemaining}s${getHintText()}`;
+    timerInterval = setInterval(updateTimer, 1000);
+}
+
+function stopTimer() {
+    if (timerInterval) {
+        clearInterval(timerInterval);
+        timerInterval = null;
+    }
+}
 
 /* ---------- Initialization ---------- */
 
@@ -258,7 +519,9 @@ function sendJoinMessage() {
     lobbyStatusEl.innerText = "Waiting for players... (1/2)";
 }
 
-function join(){
+// vsBot: ask for the bot as opponent. If another player already took the
+// seat and joined, the server pairs us with them instead.
+function join(vsBot){
     playerName = document.getElementById("name").value.trim();
     if(!playerName) return alert("Please enter a name.");
     
@@ -268,11 +531,14 @@ function join(){
     }
     
     const message = { type: 'join', name: playerName };
+    if (vsBot) {
+        message.bot = true;
+    }
     ws.send(JSON.stringify(message));
     
     document.getElementById("namePage").style.display = "none";
     document.getElementById("lobbyPage").style.display = "block";
-    lobbyStatusEl.innerText = "Waiting for players... (1/2)";
+    lobbyStatusEl.innerText = vsBot ? "Starting game against the bot..." : "Waiting for players... (1/2)";
 }
 
 function startGame(){
@@ -286,8 +552,8 @@ function startGame(){
 /* ---------- Board Rendering ---------- */
 function resetBoardState() {
     currentRow = 0;
-    boardState = Array.from({length: MAX_ROWS}, () => Array(5).fill(""));
-    boardColors = Array.from({length: MAX_ROWS}, () => Array(5).fill(""));  // ADD THIS
+    boardState = Array.from({length: MAX_ROWS}, () => Array(WORD_LEN).fill(""));
+    boardColors = Array.from({length: MAX_ROWS}, () => Array(WORD_LEN).fill(""));  // ADD THIS
     lockedRows = Array(MAX_ROWS).fill(false);
     gameOver = false;
     statusEl.innerText = "";
@@ -300,7 +566,7 @@ function renderBoard() {
         const row = document.createElement("div");
         row.className = "row";
         row.dataset.row = r;
-        for (let c = 0; c < 5; c++) {
+        for (let c = 0; c < WORD_LEN; c++) {
             const tile = document.createElement("div");
             tile.className = "tile";
             tile.dataset.row = r;
@@ -333,9 +599,9 @@ function highlightCurrentRow() {
 inputEl.addEventListener("input", (e) => {
     if (gameOver) return;
     let val = e.target.value.toUpperCase().replace(/[^A-Z]/g,'');
-    if (val.length > 5) val = val.slice(0,5);
+    if (val.length > WORD_LEN) val = val.slice(0,WORD_LEN);
     e.target.value = val;
-    for (let c = 0; c < 5; c++) {
+    for (let c = 0; c < WORD_LEN; c++) {
         boardState[currentRow][c] = val[c] || "";
     }
     renderBoard();
@@ -349,24 +615,24 @@ function deleteLetter() {
 
 /* ---------- Guess Checking ---------- */
 function evaluateGuess(guess, secret) {
-    const result = Array(5).fill('absent');
+    const result = Array(WORD_LEN).fill('absent');
     guess = guess.toUpperCase();
     secret = secret.toUpperCase();
     const secretChars = secret.split('');
     const guessChars = guess.split('');
     const remaining = {};
 
-    for (let i = 0; i < 5; i++) {
+    for (let i = 0; i < WORD_LEN; i++) {
         if (guessChars[i] === secretChars[i]) {
             result[i] = 'correct';
             secretChars[i] = null;
             guessChars[i] = null;
         }
     }
-    for (let i = 0; i < 5; i++) {
+    for (let i = 0; i < WORD_LEN; i++) {
         if (secretChars[i]) remaining[secretChars[i]] = (remaining[secretChars[i]]||0) + 1;
     }
-    for (let i = 0; i < 5; i++) {
+    for (let i = 0; i < WORD_LEN; i++) {
         if (!guessChars[i]) continue;
         const ch = guessChars[i];
         if (remaining[ch]) {
@@ -385,8 +651,8 @@ function submitGuess(){
         return;
     }
     const guess = inputEl.value.trim().toUpperCase();
-    if (guess.length !== 5) {
-        statusEl.innerText = `Guess must be 5 letters.${getHintText()}`;
+    if (guess.length !== WORD_LEN) {
+        statusEl.innerText = `Guess must be ${WORD_LEN} letters.${getHintText()}`;
         return;
     }
     sendGuess(guess);
@@ -396,14 +662,14 @@ function submitGuess(){
 
 function applyEvaluationToRow(rowIndex, evalRes) {
     // Save the colors to our state
-    for (let c = 0; c < 5; c++) {
+    for (let c = 0; c < WORD_LEN; c++) {
         boardColors[rowIndex][c] = evalRes[c];  // ADD THIS
     }
     
     // Apply to DOM
     const rowEl = document.querySelector(`.row[data-row='${rowIndex}']`);
     if (!rowEl) return;
-    for (let c = 0; c < 5; c++) {
+    for (let c = 0; c < WORD_LEN; c++) {
         const tile = rowEl.querySelector(`.tile[data-col='${c}']`);
         if (!tile) continue;
         tile.classList.remove('correct','present','absent');
@@ -412,6 +678,7 @@ function applyEvaluationToRow(rowIndex, evalRes) {
 }
 
 function restart() {
+    if (!wsReady) return;
     const message = { type: 'next_round' };
     ws.send(JSON.stringify(message));
     restartBtn.style.display = "none";
@@ -449,6 +716,152 @@ function updateScoreDisplay() {
     scoreDisplay.innerText = `Score: You ${myScore} - ${opponentScore} Opponent`;
 }
 
+/* ---------- Reconnect ---------- */
+// Back in our seat: rebuild the screen from the server's snapshot. Rows are
+// drawn in order; turns that timed out left no row.
+function restoreSnapshot(data) {
+    const me = data.players[playerIndex];
+    const opponent = data.players[1 - playerIndex];
+    document.getElementById("namePage").style.display = "none";
+    if (!data.active) {
+        document.getElementById("gamePage").style.display = "none";
+        document.getElementById("lobbyPage").style.display = "block";
+        lobbyStatusEl.innerText = "Waiting for players... (1/2)";
+        return;
+    }
+    document.getElementById("lobbyPage").style.display = "none";
+    document.getElementById("gamePage").style.display = "block";
+
+    resetBoardState();
+    me.rows.forEach((row, r) => {
+        boardState[r] = row.word.split('');
+        boardColors[r] = row.result.map(v => v === 2 ? 'correct' : v === 1 ? 'present' : 'absent');
+        lockedRows[r] = true;
+    });
+    currentRow = Math.min(me.guesses_used, MAX_ROWS - 1);
+    roundNumber = data.round;
+    myScore = data.scores[0];
+    opponentScore = data.scores[1];
+    currentHint = data.hint_player === playerIndex
+        ? { type: data.hint_type, letter: data.hint_letter, position: data.hint_position }
+        : null;
+    const won = me.rows.some(row => row.result.every(v => v === 2));
+    roundActive = !data.round_over;
+    gameOver = data.round_over || won || me.guesses_used >= MAX_ROWS;
+    waitingForOpponent = !gameOver && me.guesses_used > opponent.guesses_used;
+    renderBoard();
+    updateScoreDisplay();
+
+    if (data.round_over) {
+        statusEl.innerText = `Round ${roundNumber} is over | Score: You ${myScore} - ${opponentScore} Opponent`;
+        restartBtn.innerText = "Next Round";
+        restartBtn.style.display = "inline-block";
+    } else if (won) {
+        statusEl.innerText = "You got it! Waiting for round to end...";
+    } else if (gameOver) {
+        statusEl.innerText = "Out of guesses! Waiting for round to end...";
+    } else if (waitingForOpponent) {
+        statusEl.innerText = "Waiting for opponent to guess...";
+    } else {
+        startTimer();
+        inputEl.focus();
+    }
+}
+
+// The server gave our seat away while we were gone. Back to the lobby if we
+// were only waiting there, otherwise start over from the name page.
+function seatLost() {
+    stopTimer();
+    if (playerName && document.getElementById("lobbyPage").style.display === "block") {
+        ws.send(JSON.stringify({ type: 'join', name: playerName }));
+        return;
+    }
+    if (document.getElementById("gamePage").style.display === "block") {
+        document.getElementById("gamePage").style.display = "none";
+        document.getElementById("namePage").style.display = "block";
+        document.getElementById("name").value = playerName;
+        alert("You were away too long, the match is over. Join again to play.");
+    }
+}
+
+/* ---------- Spectator Mode ---------- */
+// Both boards, filled only from the server: a snapshot on connect, then every
+// result in the room
+let watchBoards = [[], []];   // Per player, rows of { word, result }
+let watchScores = [0, 0];
+
+function watchHintText(data) {
+    if (data.hint_player === undefined || data.hint_player < 0) return "";
+    const hint = data.hint_type === "green"
+        ? `position ${data.hint_position + 1} is "${data.hint_letter}"`
+        : `word contains "${data.hint_letter}"`;
+    return ` | Player ${data.hint_player + 1} hint: ${hint}`;
+}
+
+function renderWatchBoards() {
+    const classes = ['absent', 'present', 'correct'];
+    for (let p = 0; p < 2; p++) {
+        const boardDiv = document.getElementById("watchBoard" + p);
+        boardDiv.innerHTML = "";
+        for (let r = 0; r < MAX_ROWS; r++) {
+            const row = document.createElement("div");
+            row.className = "row";
+            const guess = watchBoards[p][r];
+            for (let c = 0; c < WORD_LEN; c++) {
+                const tile = document.createElement("div");
+                tile.className = "tile";
+                if (guess) {
+                    tile.innerText = guess.word[c];
+                    tile.classList.add(classes[guess.result[c]]);
+                }
+                row.appendChild(tile);
+            }
+            boardDiv.appendChild(row);
+        }
+    }
+    document.getElementById("watchScore").innerText =
+        `Round ${roundNumber} | Player 1 ${watchScores[0]} - ${watchScores[1]} Player 2`;
+}
+
+function handleWatchMessage(data) {
+    const watchStatusEl = document.getElementById("watchStatus");
+    if (data.type === 'snapshot') {
+        roundNumber = data.round;
+        watchScores = data.scores.slice();
+        watchBoards = data.players.map(p => p.rows.slice());
+        if (!data.active) {
+            watchStatusEl.innerText = "Waiting for players...";
+        } else {
+            watchStatusEl.innerText = (data.round_over ? "Round over" : "Round in progress") + watchHintText(data);
+        }
+    }
+    else if (data.type === 'game_starting') {
+        watchStatusEl.innerText = "Game starting!";
+    }
+    else if (data.type === 'round_start') {
+        roundNumber = data.round;
+        watchBoards = [[], []];
+        watchStatusEl.innerText = `Round ${data.round} started${watchHintText(data)}`;
+    }
+    else if (data.type === 'result') {
+        watchBoards[data.player].push({ word: data.word, result: data.result });
+        if (data.is_correct) {
+            watchStatusEl.innerText = `Player ${data.player + 1} guessed it!`;
+        }
+    }
+    else if (data.type === 'round_end') {
+        watchScores = [data.player1_score, data.player2_score];
+        const winner = data.winner === -1 ? "Tie!" : `Player ${data.winner + 1} won the round!`;
+        watchStatusEl.innerText = `${winner} | Word was: ${data.target_word}`;
+    }
+    renderWatchBoards();
+}
+
 // Initial render
 resetBoardState();
+if (watchRoom !== null) {
+    document.getElementById("namePage").style.display = "none";
+    document.getElementById("watchPage").style.display = "block";
+    renderWatchBoards();
+}
 renderBoard();
\ No newline at end of file
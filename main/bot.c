@@ -0,0 +1,118 @@
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "wordle_server.h"
+#include "wordle_solver.h"
+#include "bot.h"
+
+static const char *TAG = "wordle bot";
+
+#define BOT_QUEUE_LEN  16
+#define BOT_CORE       (portNUM_PROCESSORS - 1)   // httpd is pinned to core 0
+
+typedef struct {
+    uint8_t room;
+    uint8_t slot;
+    wordle_msg_t msg;
+} bot_event_t;
+
+// What the bot knows about its round: only its own guesses and their
+// feedback. Candidates are rebuilt from this each turn, which costs a few
+// thousand lookups and saves keeping a candidate list per room.
+typedef struct {
+    const wordle_variant_t *variant;  // Length of the round, from its round_start
+    uint16_t guesses[WORDLE_MAX_ROWS];
+    wordle_fb_t codes[WORDLE_MAX_ROWS];
+    uint8_t results;         // Guesses with feedback so far
+    uint8_t turns;           // Guesses used, timeouts included
+    uint16_t pending;        // Last guess submitted, waiting for its result
+    bool in_round;
+    bool won;
+} bot_room_t;
+
+static QueueHandle_t bot_events;
+static bot_submit_fn bot_submit;
+static bot_room_t bot_rooms[WORDLE_MAX_ROOMS];
+static wordle_solver_t solver;
+
+static void play_turn(int r)
+{
+    bot_room_t *bot = &bot_rooms[r];
+    const wordle_variant_t *v = bot->variant;
+    if (!bot->in_round || bot->won || bot->turns >= v->max_guesses) {
+        return;
+    }
+
+    int64_t start = esp_timer_get_time();
+    v->solver_reset(&solver);
+    for (int i = 0; i < bot->results; i++) {
+        v->solver_filter(&solver, bot->guesses[i], bot->codes[i]);
+    }
+    bot->pending = v->solver_best_guess(&solver);
+    ESP_LOGD(TAG, "room %d: %u candidates, guess in %lld us", r, solver.count,
+             (long long)(esp_timer_get_time() - start));
+    bot_submit(r, v->answers[bot->pending], v->word_len);
+}
+
+static void handle_event(const bot_event_t *event)
+{
+    bot_room_t *bot = &bot_rooms[event->room];
+    const wordle_msg_t *msg = &event->msg;
+
+    switch (msg->type) {
+    case WORDLE_MSG_ROUND_START:
+        memset(bot, 0, sizeof(*bot));
+        bot->variant = msg->variant;
+        bot->in_round = true;
+        play_turn(event->room);
+        break;
+    case WORDLE_MSG_RESULT:
+        if (msg->result.player == event->slot && bot->results < WORDLE_MAX_ROWS) {
+            bot->guesses[bot->results] = bot->pending;
+            bot->codes[bot->results] = msg->result.code;
+            bot->results++;
+            bot->turns++;
+            bot->won = msg->result.is_correct;
+        }
+        break;
+    case WORDLE_MSG_TIMEOUT:
+        bot->turns++;
+        break;
+    case WORDLE_MSG_BOTH_GUESSED:
+        play_turn(event->room);
+        break;
+    case WORDLE_MSG_ROUND_END:
+        bot->in_round = false;
+        break;
+    default:
+        break;
+    }
+}
+
+static void bot_task(void *pvParameters)
+{
+    bot_event_t event;
+    while (1) {
+        xQueueReceive(bot_events, &event, portMAX_DELAY);
+        handle_event(&event);
+    }
+}
+
+void bot_post(int room, int slot, const wordle_msg_t *msg)
+{
+    bot_event_t event = { .room = (uint8_t)room, .slot = (uint8_t)slot, .msg = *msg };
+    if (xQueueSend(bot_events, &event, 0) != pdTRUE) {
+        // The turn deadline still moves the game on without the bot's guess
+        ESP_LOGW(TAG, "Bot queue full, dropped message for room %d", room);
+    }
+}
+
+void bot_init(bot_submit_fn submit)
+{
+    bot_submit = submit;
+    bot_events = xQueueCreate(BOT_QUEUE_LEN, sizeof(bot_event_t));
+    xTaskCreatePinnedToCore(bot_task, "wordle_bot", 4096, NULL, tskIDLE_PRIORITY + 2, NULL, BOT_CORE);
+}
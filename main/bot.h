@@ -0,0 +1,19 @@
+#ifndef BOT_H
+#define BOT_H
+
+#include "wordle_engine.h"
+
+// Single-player opponent: the entropy solver, run on its own task pinned to
+// the core httpd is not on, so a solve never delays socket handling.
+
+// Called on the bot task with the bot's next guess for a room, word_len
+// letters long. The receiver must hand it to the game's task, where it is
+// played like a received guess.
+typedef void (*bot_submit_fn)(int room, wordle_word_t guess, int word_len);
+
+void bot_init(bot_submit_fn submit);
+
+// Engine message for the bot seated in room (slot), from the game's task
+void bot_post(int room, int slot, const wordle_msg_t *msg);
+
+#endif // BOT_H
@@ -0,0 +1,42 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/param.h>
+#include "http_out.h"
+
+static void http_out_flush(http_out_t *out)
+{
+    if (out->used > 0) {
+        httpd_resp_send_chunk(out->req, out->buf, out->used);
+        out->used = 0;
+    }
+}
+
+void http_out_write(http_out_t *out, const char *data, size_t len)
+{
+    len = MIN(len, sizeof(out->buf));
+    if (out->used + len > sizeof(out->buf)) {
+        http_out_flush(out);
+    }
+    memcpy(out->buf + out->used, data, len);
+    out->used += len;
+}
+
+void http_out_printf(http_out_t *out, const char *fmt, ...)
+{
+    char line[128];
+    va_list ap;
+    va_start(ap, fmt);
+    int n = vsnprintf(line, sizeof(line), fmt, ap);
+    va_end(ap);
+    if (n <= 0) {
+        return;
+    }
+    http_out_write(out, line, MIN(n, (int)sizeof(line) - 1));
+}
+
+esp_err_t http_out_end(http_out_t *out)
+{
+    http_out_flush(out);
+    return httpd_resp_send_chunk(out->req, NULL, 0);
+}
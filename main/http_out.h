@@ -0,0 +1,23 @@
+#ifndef HTTP_OUT_H
+#define HTTP_OUT_H
+
+#include <stddef.h>
+#include "esp_http_server.h"
+
+// Chunked response assembled in a stack buffer, so each chunk is a few
+// hundred bytes rather than one line. Start with { .req = req }.
+typedef struct {
+    httpd_req_t *req;
+    size_t used;
+    char buf[512];
+} http_out_t;
+
+void http_out_write(http_out_t *out, const char *data, size_t len);
+
+// Lines longer than 127 bytes are cut
+void http_out_printf(http_out_t *out, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+
+// Send what is buffered and the terminating empty chunk
+esp_err_t http_out_end(http_out_t *out);
+
+#endif // HTTP_OUT_H
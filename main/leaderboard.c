@@ -0,0 +1,279 @@
+#include <stdio.h>
+#include <string.h>
+#include <sys/param.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "nvs.h"
+#include "wordle_stats.h"
+#include "http_out.h"
+#include "leaderboard.h"
+
+// The stats live in RAM and every round only marks entries dirty. A low
+// priority task wakes every CONFIG_WORDLE_STATS_FLUSH_S, copies what changed
+// under the lock and writes it with one commit, so flash erases never stall
+// the engine and a busy minute costs one write per player rather than one per
+// round. A reboot loses at most one interval. The word decks' positions ride
+// along, a few bytes rewritten only when a round has started since.
+
+#ifndef CONFIG_WORDLE_STATS_FLUSH_S
+#define CONFIG_WORDLE_STATS_FLUSH_S 30
+#endif
+
+#define NVS_NAMESPACE  "wordle"
+// Bump the low byte when an entry or round layout changes. A build with
+// another set of word lengths or row count has other answers, decks and
+// histograms, so its saves don't load either.
+#define STATS_VERSION  (2 | WORDLE_MAX_ROWS << 8 | WORDLE_WORD_LEN_MASK << 16)
+
+static const char *TAG = "leaderboard";
+
+static wordle_stats_t stats;
+static portMUX_TYPE stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// Flush task's copy of what it is writing, static to keep it off its stack
+static wordle_stats_entry_t flush_entries[WORDLE_STATS_PLAYERS];
+
+typedef struct {
+    uint32_t rounds;
+    wordle_stats_round_t history[WORDLE_STATS_HISTORY];
+} saved_history_t;
+
+static saved_history_t flush_history;
+
+// Last position noted of each length's deck, by wordle_variants[] index, and
+// whether any is newer than what NVS holds
+static wordle_deck_pos_t deck_pos[WORDLE_VARIANT_COUNT];
+static bool deck_saved;    // deck_pos came from NVS
+static bool deck_dirty;
+
+static void entry_key(char *key, int i)
+{
+    snprintf(key, 8, "p%02d", i);
+}
+
+static void load(void)
+{
+    nvs_handle_t nvs;
+    if (nvs_open(NVS_NAMESPACE, NVS_READONLY, &nvs) != ESP_OK) {
+        return;  // Nothing saved yet
+    }
+
+    uint32_t version = 0;
+    if (nvs_get_u32(nvs, "ver", &version) != ESP_OK || version != STATS_VERSION) {
+        ESP_LOGW(TAG, "Saved stats are version %lu, starting fresh", (unsigned long)version);
+        nvs_close(nvs);
+        return;
+    }
+
+    int players = 0;
+    for (int i = 0; i < WORDLE_STATS_PLAYERS; i++) {
+        char key[8];
+        entry_key(key, i);
+        size_t len = sizeof(stats.entries[i]);
+        if (nvs_get_blob(nvs, key, &stats.entries[i], &len) != ESP_OK || len != sizeof(stats.entries[i])) {
+            memset(&stats.entries[i], 0, sizeof(stats.entries[i]));
+        }
+        stats.entries[i].name[WORDLE_STATS_NAME_LEN - 1] = '\0';
+        players += stats.entries[i].name[0] != '\0';
+    }
+
+    size_t len = sizeof(flush_history);
+    if (nvs_get_blob(nvs, "hist", &flush_history, &len) == ESP_OK && len == sizeof(flush_history)) {
+        stats.rounds = flush_history.rounds;
+        memcpy(stats.history, flush_history.history, sizeof(stats.history));
+    }
+
+    len = sizeof(deck_pos);
+    deck_saved = nvs_get_blob(nvs, "deck", deck_pos, &len) == ESP_OK && len == sizeof(deck_pos);
+    nvs_close(nvs);
+    ESP_LOGI(TAG, "Loaded %d players, %lu rounds", players, (unsigned long)stats.rounds);
+}
+
+// Write out whatever changed since the last flush. Anything that fails to
+// write is marked dirty again for the next attempt.
+static void flush(void)
+{
+    portENTER_CRITICAL(&stats_lock);
+    uint32_t dirty = stats.dirty;
+    bool history_dirty = stats.history_dirty;
+    for (int i = 0; i < WORDLE_STATS_PLAYERS; i++) {
+        if (dirty & (1u << i)) {
+            flush_entries[i] = stats.entries[i];
+        }
+    }
+    if (history_dirty) {
+        flush_history.rounds = stats.rounds;
+        memcpy(flush_history.history, stats.history, sizeof(flush_history.history));
+    }
+    bool save_deck = deck_dirty;
+    wordle_deck_pos_t pos[WORDLE_VARIANT_COUNT];
+    memcpy(pos, deck_pos, sizeof(pos));
+    stats.dirty = 0;
+    stats.history_dirty = false;
+    deck_dirty = false;
+    portEXIT_CRITICAL(&stats_lock);
+
+    if (dirty == 0 && !history_dirty && !save_deck) {
+        return;
+    }
+
+    nvs_handle_t nvs;
+    esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &nvs);
+    uint32_t failed = dirty;
+    bool history_failed = history_dirty;
+    if (err == ESP_OK) {
+        err = nvs_set_u32(nvs, "ver", STATS_VERSION);
+        for (int i = 0; err == ESP_OK && i < WORDLE_STATS_PLAYERS; i++) {
+            if (dirty & (1u << i)) {
+                char key[8];
+                entry_key(key, i);
+                err = nvs_set_blob(nvs, key, &flush_entries[i], sizeof(flush_entries[i]));
+            }
+        }
+        if (err == ESP_OK && history_dirty) {
+            err = nvs_set_blob(nvs, "hist", &flush_history, sizeof(flush_history));
+        }
+        if (err == ESP_OK && save_deck) {
+            err = nvs_set_blob(nvs, "deck", pos, sizeof(pos));
+        }
+        if (err == ESP_OK) {
+            err = nvs_commit(nvs);
+        }
+        nvs_close(nvs);
+        if (err == ESP_OK) {
+            failed = 0;
+            history_failed = false;
+        }
+    }
+
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Saving stats failed: %s", esp_err_to_name(err));
+        portENTER_CRITICAL(&stats_lock);
+        stats.dirty |= failed;
+        stats.history_dirty |= history_failed;
+        deck_dirty |= save_deck;  // A newer position may be noted meanwhile, either is fine
+        portEXIT_CRITICAL(&stats_lock);
+    } else {
+        ESP_LOGI(TAG, "Saved %d players%s", __builtin_popcount(dirty), history_dirty ? " and history" : "");
+    }
+}
+
+static void flush_task(void *arg)
+{
+    for (;;) {
+        vTaskDelay(pdMS_TO_TICKS(CONFIG_WORDLE_STATS_FLUSH_S * 1000));
+        flush();
+    }
+}
+
+void leaderboard_init(void)
+{
+    wordle_stats_init(&stats);
+    load();
+    // Below everything that serves players: flash writes can take tens of ms
+    xTaskCreate(flush_task, "stats_flush", 3072, NULL, 1, NULL);
+}
+
+void leaderboard_record(const game_state_t *game, int winner)
+{
+    portENTER_CRITICAL(&stats_lock);
+    wordle_stats_record(&stats, game, winner);
+    portEXIT_CRITICAL(&stats_lock);
+}
+
+void leaderboard_deck_load(wordle_deck_t decks[WORDLE_VARIANT_COUNT])
+{
+    for (int i = 0; deck_saved && i < WORDLE_VARIANT_COUNT; i++) {
+        const wordle_variant_t *v = wordle_variants[i];
+        const wordle_deck_pos_t *pos = &deck_pos[i];
+        if (v->deck_restore(&decks[i], pos)) {
+            ESP_LOGI(TAG, "%d-letter word deck restored, %u/%u/%u dealt", v->word_len,
+                     pos->dealt[0], pos->dealt[1], pos->dealt[2]);
+        }
+    }
+    // Until a round notes it, what NVS holds is each deck as restored or dealt afresh
+    for (int i = 0; i < WORDLE_VARIANT_COUNT; i++) {
+        deck_pos[i] = decks[i].pos;
+    }
+}
+
+void leaderboard_deck_note(const wordle_variant_t *variant, const wordle_deck_t *deck)
+{
+    portENTER_CRITICAL(&stats_lock);
+    deck_pos[variant->index] = deck->pos;
+    deck_dirty = true;
+    portEXIT_CRITICAL(&stats_lock);
+}
+
+// Player names come from clients: escape them as JSON strings
+static void out_string(http_out_t *out, const char *s)
+{
+    char esc[WORDLE_STATS_NAME_LEN * 6 + 3];
+    size_t n = 0;
+    esc[n++] = '"';
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') {
+            esc[n++] = '\\';
+            esc[n++] = c;
+        } else if (c < 0x20) {
+            n += snprintf(esc + n, sizeof(esc) - n, "\\u%04x", c);
+        } else {
+            esc[n++] = c;
+        }
+    }
+    esc[n++] = '"';
+    http_out_write(out, esc, n);
+}
+
+esp_err_t leaderboard_get_handler(httpd_req_t *req)
+{
+    // Copy under the lock and format from the copy. Static: a couple of KB,
+    // and httpd runs one handler at a time.
+    static wordle_stats_t snap;
+    uint8_t order[WORDLE_STATS_PLAYERS];
+
+    portENTER_CRITICAL(&stats_lock);
+    snap = stats;
+    portEXIT_CRITICAL(&stats_lock);
+    int count = wordle_stats_rank(&snap, order, WORDLE_STATS_PLAYERS);
+
+    httpd_resp_set_type(req, "application/json");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-store");
+
+    http_out_t out = { .req = req };
+    http_out_printf(&out, "{\"players\":[");
+    for (int i = 0; i < count; i++) {
+        const wordle_stats_entry_t *e = &snap.entries[order[i]];
+        http_out_printf(&out, "%s{\"name\":", i ? "," : "");
+        out_string(&out, e->name);
+        http_out_printf(&out, ",\"played\":%u,\"wins\":%u,\"solved\":[", e->played, e->wins);
+        for (int g = 0; g < WORDLE_MAX_ROWS; g++) {
+            http_out_printf(&out, "%s%u", g ? "," : "", e->solved[g]);
+        }
+        http_out_printf(&out, "]}");
+    }
+
+    // Newest round first
+    http_out_printf(&out, "],\"rounds\":%lu,\"history\":[", (unsigned long)snap.rounds);
+    int kept = MIN(snap.rounds, WORDLE_STATS_HISTORY);
+    for (int i = 0; i < kept; i++) {
+        const wordle_stats_round_t *round = &snap.history[(snap.rounds - 1 - i) % WORDLE_STATS_HISTORY];
+        char word[WORDLE_MAX_WORD_LEN + 1] = "";
+        const wordle_variant_t *v = wordle_variant_get(round->word_len);
+        if (v != NULL) {
+            v->unpack(round->target, word);
+        }
+        http_out_printf(&out, "%s{\"word\":\"%s\",\"winner\":%d,\"players\":[", i ? "," : "", word, round->winner);
+        for (int p = 0; p < WORDLE_MAX_PLAYERS; p++) {
+            http_out_printf(&out, "%s{\"name\":", p ? "," : "");
+            out_string(&out, round->names[p]);
+            http_out_printf(&out, ",\"guesses\":%u,\"solved\":%s}", round->guesses[p],
+                       round->solved & (1u << p) ? "true" : "false");
+        }
+        http_out_printf(&out, "]}");
+    }
+    http_out_printf(&out, "]}");
+    return http_out_end(&out);
+}
@@ -0,0 +1,27 @@
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include "esp_http_server.h"
+#include "wordle_engine.h"
+
+// Leaderboard, match history and the word deck positions, saved to NVS in the
+// background. Call
+// init after nvs_flash_init(); it loads what was saved and starts the flush
+// task.
+void leaderboard_init(void);
+
+// A room's round ended, from whichever task runs the engine. Only touches
+// RAM; the flush task writes the change out later.
+void leaderboard_record(const game_state_t *game, int winner);
+
+// Each word length's deck position, saved alongside so words do not repeat
+// across a reboot. load replaces the freshly shuffled decks, one per
+// wordle_variants[] entry, with the saved ones, if any; note is called after
+// each draw from a variant's deck, from the engine's task.
+void leaderboard_deck_load(wordle_deck_t decks[WORDLE_VARIANT_COUNT]);
+void leaderboard_deck_note(const wordle_variant_t *variant, const wordle_deck_t *deck);
+
+// GET /leaderboard, JSON
+esp_err_t leaderboard_get_handler(httpd_req_t *req);
+
+#endif // LEADERBOARD_H
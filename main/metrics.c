@@ -0,0 +1,207 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "lwip/sockets.h"
+#include "wordle_metrics.h"
+#include "wordle_pool.h"
+#include "wordle_server.h"
+#include "http_out.h"
+#include "metrics.h"
+
+// Everything here is plain counters written by one task each (histograms by
+// the sender, frames in, drops and kicks by httpd, frames out by the sender).
+// A scrape may see a sample half-applied; rates over a few seconds make that
+// invisible.
+
+enum { FRAMES_IN, FRAMES_OUT, BYTES_IN, BYTES_OUT, DROPPED_RATE, DROPPED_STATE, CONN_COUNTERS };
+
+typedef struct {
+    uint32_t counters[CONN_COUNTERS];
+} conn_stats_t;
+
+static const char *conn_counter_names[CONN_COUNTERS] = {
+    "frames_in", "frames_out", "bytes_in", "bytes_out", "dropped_rate", "dropped_state",
+};
+
+static const char *kick_names[METRICS_KICK_COUNT] = {
+    "size", "rate", "malformed",
+};
+
+static const char *event_names[METRICS_EV_COUNT] = {
+    "connect", "join", "guess", "next_round", "deadline", "other",
+};
+
+static wordle_hist_t latency[METRICS_EV_COUNT];
+static conn_stats_t conns[WORDLE_MAX_FDS];
+static bool conn_open[WORDLE_MAX_FDS];
+static uint32_t kicked[METRICS_KICK_COUNT];
+
+void metrics_event_done(metrics_event_t event, int64_t latency_us)
+{
+    wordle_hist_add(&latency[event], latency_us > UINT32_MAX ? UINT32_MAX : (uint32_t)latency_us);
+}
+
+static conn_stats_t *conn(int fd)
+{
+    unsigned slot = (unsigned)(fd - LWIP_SOCKET_OFFSET);
+    return slot < WORDLE_MAX_FDS ? &conns[slot] : NULL;
+}
+
+void metrics_conn_open(int fd)
+{
+    conn_stats_t *c = conn(fd);
+    if (c != NULL) {
+        memset(c, 0, sizeof(*c));
+        conn_open[c - conns] = true;
+    }
+}
+
+void metrics_conn_close(int fd)
+{
+    conn_stats_t *c = conn(fd);
+    if (c != NULL) {
+        conn_open[c - conns] = false;
+    }
+}
+
+void metrics_frame_in(int fd, size_t bytes)
+{
+    conn_stats_t *c = conn(fd);
+    if (c != NULL) {
+        c->counters[FRAMES_IN]++;
+        c->counters[BYTES_IN] += bytes;
+    }
+}
+
+void metrics_frame_out(int fd, size_t bytes)
+{
+    conn_stats_t *c = conn(fd);
+    if (c != NULL) {
+        c->counters[FRAMES_OUT]++;
+        c->counters[BYTES_OUT] += bytes;
+    }
+}
+
+void metrics_frame_dropped(int fd, metrics_drop_t why)
+{
+    conn_stats_t *c = conn(fd);
+    if (c != NULL) {
+        c->counters[DROPPED_RATE + why]++;
+    }
+}
+
+void metrics_conn_kicked(metrics_kick_t why)
+{
+    kicked[why]++;
+}
+
+static void write_latency(http_out_t *out)
+{
+    http_out_printf(out, "# TYPE wordle_event_latency_us histogram\n");
+    for (int e = 0; e < METRICS_EV_COUNT; e++) {
+        const wordle_hist_t *h = &latency[e];
+        uint32_t cumulative = 0;
+        for (unsigned i = 0; i + 1 < WORDLE_HIST_BUCKETS; i++) {
+            cumulative += h->buckets[i];
+            http_out_printf(out, "wordle_event_latency_us_bucket{event=\"%s\",le=\"%lu\"} %lu\n",
+                       event_names[e], (unsigned long)wordle_hist_bound_us(i), (unsigned long)cumulative);
+        }
+        http_out_printf(out, "wordle_event_latency_us_bucket{event=\"%s\",le=\"+Inf\"} %lu\n",
+                   event_names[e], (unsigned long)h->count);
+        http_out_printf(out, "wordle_event_latency_us_sum{event=\"%s\"} %llu\n",
+                   event_names[e], (unsigned long long)h->sum_us);
+        http_out_printf(out, "wordle_event_latency_us_count{event=\"%s\"} %lu\n",
+                   event_names[e], (unsigned long)h->count);
+    }
+}
+
+static void write_connections(http_out_t *out)
+{
+    for (int m = 0; m < CONN_COUNTERS; m++) {
+        http_out_printf(out, "# TYPE wordle_conn_%s_total counter\n", conn_counter_names[m]);
+        for (int i = 0; i < WORDLE_MAX_FDS; i++) {
+            if (conn_open[i]) {
+                http_out_printf(out, "wordle_conn_%s_total{fd=\"%d\"} %lu\n", conn_counter_names[m],
+                           i + LWIP_SOCKET_OFFSET, (unsigned long)conns[i].counters[m]);
+            }
+        }
+    }
+    // Per reason rather than per fd: the connection is gone by the next scrape
+    http_out_printf(out, "# TYPE wordle_conns_kicked_total counter\n");
+    for (int k = 0; k < METRICS_KICK_COUNT; k++) {
+        http_out_printf(out, "wordle_conns_kicked_total{reason=\"%s\"} %lu\n",
+                   kick_names[k], (unsigned long)kicked[k]);
+    }
+}
+
+static void write_memory(http_out_t *out)
+{
+    http_out_printf(out, "# TYPE wordle_heap_free_bytes gauge\n");
+    http_out_printf(out, "wordle_heap_free_bytes %u\n", (unsigned)heap_caps_get_free_size(MALLOC_CAP_8BIT));
+    http_out_printf(out, "# TYPE wordle_heap_min_free_bytes gauge\n");
+    http_out_printf(out, "wordle_heap_min_free_bytes %u\n", (unsigned)heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT));
+    http_out_printf(out, "# TYPE wordle_heap_largest_block_bytes gauge\n");
+    http_out_printf(out, "wordle_heap_largest_block_bytes %u\n", (unsigned)heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
+
+    wordle_pool_stats_t pool;
+    wordle_pool_get_stats(&pool);
+    http_out_printf(out, "# TYPE wordle_pool_in_use gauge\n");
+    for (int c = 0; c < WORDLE_POOL_CLASSES; c++) {
+        http_out_printf(out, "wordle_pool_in_use{size=\"%u\"} %u\n", pool.classes[c].block_size, pool.classes[c].in_use);
+    }
+    http_out_printf(out, "# TYPE wordle_pool_high_water gauge\n");
+    for (int c = 0; c < WORDLE_POOL_CLASSES; c++) {
+        http_out_printf(out, "wordle_pool_high_water{size=\"%u\"} %u\n", pool.classes[c].block_size, pool.classes[c].high_water);
+    }
+    http_out_printf(out, "# TYPE wordle_pool_fallbacks_total counter\n");
+    http_out_printf(out, "wordle_pool_fallbacks_total %lu\n", (unsigned long)pool.fallbacks);
+}
+
+static void write_tasks(http_out_t *out)
+{
+#if CONFIG_FREERTOS_USE_TRACE_FACILITY
+    // A few spare entries in case a task starts between the two calls
+    UBaseType_t count = uxTaskGetNumberOfTasks() + 4;
+    TaskStatus_t *tasks = malloc(count * sizeof(TaskStatus_t));
+    if (tasks == NULL) {
+        return;
+    }
+    uint32_t total_runtime = 0;
+    count = uxTaskGetSystemState(tasks, count, &total_runtime);
+
+#if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+    // CPU share is rate(task) / rate(total) over the scrape interval
+    http_out_printf(out, "# TYPE wordle_task_runtime_total counter\n");
+    http_out_printf(out, "wordle_task_runtime_total{task=\"_all\"} %lu\n", (unsigned long)total_runtime);
+    for (UBaseType_t i = 0; i < count; i++) {
+        http_out_printf(out, "wordle_task_runtime_total{task=\"%s\"} %lu\n",
+                   tasks[i].pcTaskName, (unsigned long)tasks[i].ulRunTimeCounter);
+    }
+#endif
+    http_out_printf(out, "# TYPE wordle_task_stack_free_min_bytes gauge\n");
+    for (UBaseType_t i = 0; i < count; i++) {
+        http_out_printf(out, "wordle_task_stack_free_min_bytes{task=\"%s\"} %u\n",
+                   tasks[i].pcTaskName, (unsigned)tasks[i].usStackHighWaterMark);
+    }
+    free(tasks);
+#endif
+}
+
+esp_err_t metrics_get_handler(httpd_req_t *req)
+{
+    httpd_resp_set_type(req, "text/plain; version=0.0.4");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-store");
+
+    http_out_t out = { .req = req };
+    http_out_printf(&out, "# TYPE wordle_uptime_us counter\nwordle_uptime_us %lld\n",
+               (long long)esp_timer_get_time());
+    write_latency(&out);
+    write_connections(&out);
+    write_memory(&out);
+    write_tasks(&out);
+    return http_out_end(&out);
+}
@@ -0,0 +1,49 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stdint.h>
+#include "esp_http_server.h"
+
+// What woke the game: latency is measured from the frame (or timer) arriving
+// to the sender task having written the last frame it produced
+typedef enum {
+    METRICS_EV_CONNECT,
+    METRICS_EV_JOIN,
+    METRICS_EV_GUESS,
+    METRICS_EV_NEXT_ROUND,
+    METRICS_EV_DEADLINE,
+    METRICS_EV_OTHER,
+    METRICS_EV_COUNT
+} metrics_event_t;
+
+// Sender task only
+void metrics_event_done(metrics_event_t event, int64_t latency_us);
+
+// Per-connection traffic, fd as handed out by httpd
+void metrics_conn_open(int fd);
+void metrics_conn_close(int fd);
+void metrics_frame_in(int fd, size_t bytes);
+void metrics_frame_out(int fd, size_t bytes);
+
+// Frames from a client that were thrown away unparsed (httpd task), and
+// clients closed for misbehaving
+typedef enum {
+    METRICS_DROP_RATE,       // Over the connection's frame rate
+    METRICS_DROP_STATE,      // A message the game is not expecting from it now
+    METRICS_DROP_COUNT
+} metrics_drop_t;
+
+typedef enum {
+    METRICS_KICK_SIZE,       // Frame larger than any client message
+    METRICS_KICK_RATE,       // Kept flooding after its frames were dropped
+    METRICS_KICK_MALFORMED,  // Not a client message at all
+    METRICS_KICK_COUNT
+} metrics_kick_t;
+
+void metrics_frame_dropped(int fd, metrics_drop_t why);
+void metrics_conn_kicked(metrics_kick_t why);
+
+// GET /metrics, Prometheus text format
+esp_err_t metrics_get_handler(httpd_req_t *req);
+
+#endif // METRICS_H
@@ -6,56 +6,184 @@
    software is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
    CONDITIONS OF ANY KIND, either express or implied.
 */
+#include <stdlib.h>
 #include <string.h>
+#include <sys/param.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/queue.h"
 #include "esp_mac.h"
 #include "esp_wifi.h"
 #include "esp_event.h"
 #include "esp_log.h"
 #include "nvs_flash.h"
 #include "esp_http_server.h"
+#include "esp_timer.h"
 #include "cJSON.h"
-#include "words.h"
+#include "wordle_server.h"
+#include "wordle_json.h"
+#include "wordle_proto.h"
+#include "wordle_pool.h"
+#include "wordle_outq.h"
+#include "wordle_frame.h"
+#include "wordle_inbound.h"
+#include "wordle_rate.h"
+#include "wordle_trace.h"
+#include "metrics.h"
+#include "leaderboard.h"
+#include "http_out.h"
+#include "bot.h"
 
 
 #include "lwip/err.h"
 #include "lwip/sys.h"
+#include "lwip/sockets.h"
 
 
 
-extern const char html_start[] asm("_binary_index_html_start");
-extern const char html_end[] asm("_binary_index_html_end");
+#include "wordle_assets.h"
 
-extern const char css_start[] asm("_binary_style_css_start");
-extern const char css_end[] asm("_binary_style_css_end");
+// Minified, gzipped copies of assets/, see tools/pack_assets.py
+extern const char html_start[] asm("_binary_index_html_gz_start");
+extern const char html_end[] asm("_binary_index_html_gz_end");
 
-extern const char js_start[] asm("_binary_script_js_start");
-extern const char js_end[] asm("_binary_script_js_end");
+extern const char css_start[] asm("_binary_style_css_gz_start");
+extern const char css_end[] asm("_binary_style_css_gz_end");
 
+extern const char js_start[] asm("_binary_script_js_gz_start");
+extern const char js_end[] asm("_binary_script_js_gz_end");
+
+// Global game state: every room, indexed by socket. Owned by game_task; the
+// httpd, timer and bot tasks only post events to it.
+static wordle_server_t game_server;
+static httpd_handle_t server = NULL;
+
+// Clients that asked for the binary protocol at the handshake (/ws?proto=bin),
+// indexed like the server's fd table
+static bool binary_fd[WORDLE_MAX_FDS];
+
+// Client frames are a short JSON object received on the httpd task's stack.
+// No client message comes near this; a larger frame closes the socket before
+// its payload is read.
+#define WS_RX_BUF_LEN 128
+
+// Frame rate per connection, httpd task only; reset at the handshake
+static wordle_rate_t rx_rate[WORDLE_MAX_FDS];
+
+// Messages each connection may send right now, bit (1 << wordle_in_type_t),
+// so httpd can drop the rest without bothering game_task. Written by
+// game_task after every event (and by httpd at the handshake, before the
+// connection is known to game_task), read by httpd. A stale mask only
+// drops or forwards a frame the engine would have decided the same way.
+static uint8_t fd_accepts[WORDLE_MAX_FDS];
+#define ACCEPTS(type) (1u << (type))
+
+// Outbound queue per seat, drained by sender_task
+static wordle_outq_t outq[WORDLE_MAX_ROOMS][WORDLE_MAX_PLAYERS];
+
+// Welcome back and snapshot for a seat taken back after a drop, encoded on
+// game_task and written by sender_task ahead of the seat's outq
+static wordle_frameq_t resume_frames[WORDLE_MAX_ROOMS][WORDLE_MAX_PLAYERS];
+
+// Spectators: read-only connections (/ws?watch=N) following one room. For
+// JSON viewers each room's events are encoded once at the end of the event
+// into a shared frame, and every one of them queues a reference to it. Binary
+// messages encode faster than a shared frame costs to hand around, so binary
+// viewers get the messages themselves, encoded per viewer like a player's.
+// The table is only changed on game_task; sender_task drains the queues.
+#define MAX_SPECTATORS CONFIG_ESP_MAX_STA_CONN
 typedef struct {
-    int fd;
-    bool connected;
-    char name[32];
-    int guesses_used;
-    bool has_won;
-    int score;
-    bool waiting_for_opponent;  //Has the opponent submitted a guess
-} player_t;
+    int fd;                  // -1 = free
+    int room;
+    bool binary;
+    wordle_frameq_t frames;  // Snapshot, then shared JSON frames
+    wordle_outq_t msgs;      // Binary viewers' messages
+} spectator_t;
+static spectator_t spectators[MAX_SPECTATORS];
+static int watchers[WORDLE_MAX_ROOMS];   // Spectators per room
+
+// Room-wide messages of the event in progress, per room with spectators
+typedef struct {
+    int count;
+    wordle_msg_t msgs[WORDLE_OUTQ_LEN];
+} watch_batch_t;
+static watch_batch_t watch_batch[WORDLE_MAX_ROOMS];
 
+// Finished events, posted to sender_task once their messages are queued
 typedef struct {
-    player_t players[2];
-    int player_count;
-    bool game_active;
-    char target_word[6];
-    int round_number;        // Current round
-    time_t round_start_time; // When the round started (for 45s timer)
-    bool round_over;         // Has this round ended?
-} game_state_t;
-
-// Global game state
-static game_state_t game = {0};
-static httpd_handle_t server = NULL;
+    metrics_event_t type;
+    int64_t start_us;        // When the frame or timer arrived
+} sender_event_t;
+#define SENDER_EVENTS 16
+static QueueHandle_t sender_events;
+
+// Sockets game_task is done with, closed by sender_task at the end of its
+// next pass. An fd is only reused by lwIP once closed, so each one is here at
+// most once and the queue never fills.
+static QueueHandle_t sender_closes;
+
+// Everything that changes game state, decoded by whoever noticed it and
+// handled in order by game_task. Small and fixed-size so posting is a copy.
+typedef enum {
+    GAME_EV_OPEN,            // WebSocket handshake done
+    GAME_EV_JOIN,
+    GAME_EV_GUESS,
+    GAME_EV_NEXT_ROUND,
+    GAME_EV_CLOSE,           // Socket gone, sender_task closes the fd
+    GAME_EV_DEADLINE,        // A room's turn timer fired
+    GAME_EV_FIRST_ROUND,     // A room's delayed first round is due
+    GAME_EV_HOLD_EXPIRED,    // A held seat's grace period is over
+    GAME_EV_BOT_GUESS,
+} game_event_type_t;
+
+typedef struct {
+    game_event_type_t type;
+    int fd;                  // Socket events
+    int room;                // Timer and bot events
+    int slot;                // GAME_EV_HOLD_EXPIRED
+    int64_t start_us;        // When the frame or timer arrived, for metrics
+    union {
+        struct {
+            bool binary;
+            int watch;       // -1 = player, WATCH_ANY = first room with a game on
+            uint32_t token;
+            const wordle_variant_t *variant;  // Word length asked for, NULL = default
+        } open;
+        struct {
+            char name[sizeof(((player_t *)0)->name)];
+            bool bot;
+        } join;
+        struct {
+            bool ok;         // A whole word, packed; otherwise text is echoed back as invalid
+            wordle_word_t packed;
+            uint8_t word_len;                    // Letters in packed
+            char text[WORDLE_MAX_WORD_LEN + 2];  // One spare so a long guess stays invalid
+        } guess;
+        struct {
+            wordle_word_t packed;
+            uint8_t word_len;
+        } bot_guess;
+    };
+} game_event_t;
+
+#define GAME_EVENTS   32
+#define WATCH_ANY     (-2)
+#define FIRST_ROUND_DELAY_MS 1000   // Lets both pages show game_starting
+static QueueHandle_t game_events;
+
+// Held seats: a player whose socket dropped mid-match gets the grace period to
+// reconnect with its session token, then the seat is released. One one-shot
+// timer per seat, with the token the seat was held under.
+static esp_timer_handle_t hold_timers[WORDLE_MAX_ROOMS][WORDLE_MAX_PLAYERS];
+static uint32_t hold_token[WORDLE_MAX_ROOMS][WORDLE_MAX_PLAYERS];
+
+// Turn deadlines, one one-shot esp_timer per room. Armed and checked only on
+// game_task; the timer callback just posts the room back to it.
+static esp_timer_handle_t turn_timers[WORDLE_MAX_ROOMS];
+static int64_t turn_deadline_us[WORDLE_MAX_ROOMS];   // 0 = not armed
+
+// The pause between both players joining and round 1, one per room
+static esp_timer_handle_t first_round_timers[WORDLE_MAX_ROOMS];
 
 /* The examples use WiFi configuration that you can set via project configuration menu.
 
@@ -142,289 +270,597 @@ void wifi_init_softap(void)
              EXAMPLE_ESP_WIFI_SSID, EXAMPLE_ESP_WIFI_PASS, EXAMPLE_ESP_WIFI_CHANNEL);
 }
 
-// Handler for the main HTML page
-static esp_err_t root_get_handler(httpd_req_t *req)
+typedef struct {
+    const char *start;
+    const char *end;
+    const char *type;
+    const char *etag;
+    const char *cache_control;
+} static_asset_t;
+
+// The page revalidates every load (a 304 when unchanged) and references the
+// CSS and JS by ETag, so those can be cached for good
+static const static_asset_t index_asset = {
+    html_start, html_end, "text/html", ASSET_ETAG_INDEX_HTML, "no-cache"
+};
+static const static_asset_t css_asset = {
+    css_start, css_end, "text/css", ASSET_ETAG_STYLE_CSS, "public, max-age=31536000, immutable"
+};
+static const static_asset_t js_asset = {
+    js_start, js_end, "application/javascript", ASSET_ETAG_SCRIPT_JS, "public, max-age=31536000, immutable"
+};
+
+// Handler for the embedded page, CSS and JavaScript (user_ctx is the asset)
+static esp_err_t asset_get_handler(httpd_req_t *req)
 {
-    httpd_resp_set_type(req, "text/html");
-    httpd_resp_send(req, html_start, html_end - html_start);
-    return ESP_OK;
-}
+    const static_asset_t *asset = req->user_ctx;
 
-// Handler for CSS
-static esp_err_t css_get_handler(httpd_req_t *req)
-{
-    httpd_resp_set_type(req, "text/css");
-    httpd_resp_send(req, css_start, css_end - css_start);
+    httpd_resp_set_hdr(req, "ETag", asset->etag);
+    httpd_resp_set_hdr(req, "Cache-Control", asset->cache_control);
+
+    char if_none_match[24];
+    if (httpd_req_get_hdr_value_str(req, "If-None-Match", if_none_match,
+                                    sizeof(if_none_match)) == ESP_OK &&
+        strcmp(if_none_match, asset->etag) == 0) {
+        httpd_resp_set_status(req, "304 Not Modified");
+        httpd_resp_send(req, NULL, 0);
+        return ESP_OK;
+    }
+
+    httpd_resp_set_type(req, asset->type);
+    httpd_resp_set_hdr(req, "Content-Encoding", "gzip");
+    httpd_resp_send(req, asset->start, asset->end - asset->start);
     return ESP_OK;
 }
 
-// Handler for JavaScript
-static esp_err_t js_get_handler(httpd_req_t *req)
+
+
+
+
+
+
+
+
+// Handler for the event trace: the ring buffer as text, oldest first
+static esp_err_t trace_get_handler(httpd_req_t *req)
 {
-    httpd_resp_set_type(req, "application/javascript");
-    httpd_resp_send(req, js_start, js_end - js_start);
-    return ESP_OK;
+    httpd_resp_set_type(req, "text/plain");
+    httpd_resp_set_hdr(req, "Cache-Control", "no-store");
+
+    uint32_t head = wordle_trace_head();
+    uint32_t seq = head > WORDLE_TRACE_LEN ? head - WORDLE_TRACE_LEN : 0;
+
+    http_out_t out = { .req = req };
+    for (; seq < head; seq++) {
+        wordle_trace_entry_t entry;
+        wordle_trace_read(seq, &entry);
+        char line[96];
+        int n = wordle_trace_format(&entry, line, sizeof(line));
+        if (n > 0) {
+            http_out_write(&out, line, MIN(n, (int)sizeof(line) - 1));
+        }
+    }
+    return http_out_end(&out);
 }
 
+//============================= JSON Game Logic ============================
 
 
+// Engine transport hook: queue the message for the sender task. Nothing goes
+// out until sender_kick() at the end of the event, so everything one event
+// produces for a client shares a frame.
+static void send_to_fd(void *ctx, int fd, const wordle_msg_t *msg)
+{
+    int slot;
+    if (WORDLE_IS_BOT_FD(fd)) {
+        int r = WORDLE_BOT_FD_ROOM(fd);
+        bot_post(r, wordle_find_player(&game_server.rooms[r], fd), msg);
+        return;
+    }
 
+    game_state_t *room = wordle_server_lookup(&game_server, fd, &slot);
+    if (room == NULL) {
+        return;
+    }
 
+    if (!wordle_outq_push(&outq[room - game_server.rooms][slot], msg)) {
+        // The client stopped reading. Drop it rather than hold up its opponent.
+        ESP_LOGW(TAG, "Send queue full for fd %d, closing", fd);
+        httpd_sess_trigger_close(server, fd);
+    }
+}
 
+// Engine watch hook: keep score of finished rounds and of the word deck, and
+// collect the room's messages for spectators until the event ends
+static void watch_room(void *ctx, game_state_t *game, const wordle_msg_t *msg)
+{
+    if (msg->type == WORDLE_MSG_ROUND_END) {
+        leaderboard_record(game, msg->round_end.winner);
+    } else if (msg->type == WORDLE_MSG_ROUND_START) {
+        leaderboard_deck_note(game->variant, game->deck);
+    }
 
+    int r = game - game_server.rooms;
+    watch_batch_t *batch = &watch_batch[r];
+    if (watchers[r] == 0) {
+        return;
+    }
+    if (batch->count == WORDLE_OUTQ_LEN) {
+        ESP_LOGW(TAG, "Watch batch full for room %d, dropped message", r);
+        return;
+    }
+    batch->msgs[batch->count++] = *msg;
+}
 
-//============================= JSON Game Logic ============================
+// Encode messages once for every JSON spectator. NULL on allocation failure.
+static wordle_frame_t *encode_json_frame(const wordle_msg_t *msgs, int count)
+{
+    char *str = wordle_msgs_to_json(msgs, count);
+    if (str == NULL) {
+        return NULL;
+    }
+    size_t len = strlen(str);
+    wordle_frame_t *frame = wordle_frame_alloc(len, false);
+    if (frame != NULL) {
+        memcpy(frame->data, str, len);
+    }
+    cJSON_free(str);
+    return frame;
+}
 
+// Queue a room's batch for a spectator, closing it if it fell behind. JSON
+// viewers get a reference to the shared frame, binary ones the messages.
+static void spectator_push(spectator_t *spec, const watch_batch_t *batch, wordle_frame_t *frame)
+{
+    bool queued = true;
+    if (spec->binary) {
+        for (int i = 0; i < batch->count && queued; i++) {
+            queued = wordle_outq_push(&spec->msgs, &batch->msgs[i]);
+        }
+    } else if (frame != NULL) {
+        queued = wordle_frameq_push(&spec->frames, frame);
+    }
+    if (!queued) {
+        ESP_LOGW(TAG, "Spectator queue full for fd %d, closing", spec->fd);
+        httpd_sess_trigger_close(server, spec->fd);
+    }
+}
 
-// Check a guess and return result array
-// 0 = wrong letter, 1 = correct letter wrong position, 2 = correct letter correct position
-static void check_guess(const char *guess, const char *target, int *result)
+// game_task, end of an event: fan each room's batch out to its spectators,
+// encoding it for JSON viewers at most once
+static void watch_flush(void)
 {
-    // First pass: mark exact matches
-    bool target_used[5] = {false};
-    bool guess_used[5] = {false};
-    
-    for (int i = 0; i < 5; i++) {
-        if (guess[i] == target[i]) {
-            result[i] = 2;  // Correct position
-            target_used[i] = true;
-            guess_used[i] = true;
-        } else {
-            result[i] = 0;  // Default to wrong
+    for (int r = 0; r < WORDLE_MAX_ROOMS; r++) {
+        watch_batch_t *batch = &watch_batch[r];
+        if (batch->count == 0) {
+            continue;
+        }
+        wordle_frame_t *json = NULL;
+        for (int s = 0; s < MAX_SPECTATORS; s++) {
+            spectator_t *spec = &spectators[s];
+            if (spec->fd < 0 || spec->room != r) {
+                continue;
+            }
+            if (!spec->binary && json == NULL) {
+                json = encode_json_frame(batch->msgs, batch->count);
+            }
+            spectator_push(spec, batch, json);
         }
+        // The spectators hold their own references now
+        wordle_frame_unref(json);
+        batch->count = 0;
     }
-    
-    // Second pass: mark letters in wrong position
-    for (int i = 0; i < 5; i++) {
-        if (guess_used[i]) continue;  // Already marked as correct position
-        
-        for (int j = 0; j < 5; j++) {
-            if (!target_used[j] && guess[i] == target[j]) {
-                result[i] = 1;  // Wrong position
-                target_used[j] = true;
-                break;
+}
+
+// What a seated player may send in the room's current state
+static uint8_t seat_accepts(const game_state_t *room, const player_t *player)
+{
+    if (!room->game_active) {
+        return ACCEPTS(WORDLE_IN_JOIN);
+    }
+    if (room->first_round_pending) {
+        return 0;
+    }
+    if (room->round_over) {
+        return ACCEPTS(WORDLE_IN_NEXT_ROUND);
+    }
+    if (player->has_won || player->waiting_for_opponent) {
+        return 0;
+    }
+    return ACCEPTS(WORDLE_IN_GUESS);
+}
+
+// Publish every seated player's mask for the httpd task
+static void publish_accepts(void)
+{
+    for (int r = 0; r < WORDLE_MAX_ROOMS; r++) {
+        const game_state_t *room = &game_server.rooms[r];
+        for (int p = 0; p < WORDLE_MAX_PLAYERS; p++) {
+            const player_t *player = &room->players[p];
+            unsigned slot = (unsigned)(player->fd - LWIP_SOCKET_OFFSET);
+            if (player->connected && !player->away && slot < WORDLE_MAX_FDS) {
+                fd_accepts[slot] = seat_accepts(room, player);
             }
         }
     }
 }
 
-// Send a message to a specific player
-static void send_to_player(int player_index, const char *message)
+// End of an event: wake the sender, which writes everything queued so far
+// and records the event's latency once the last frame is out
+static void sender_kick(metrics_event_t type, int64_t start_us)
+{
+    watch_flush();
+    publish_accepts();
+    sender_event_t event = { type, start_us };
+    // Full means the sender is already awake and behind; it drains every
+    // queue on its next pass regardless, only this latency sample is lost
+    xQueueSend(sender_events, &event, 0);
+}
+
+// Write one frame with everything queued for a seat since the last pass
+static void send_queued(wordle_outq_t *q)
 {
-    if (!game.players[player_index].connected) {
-        return;  // Player not connected
+    wordle_msg_t msgs[WORDLE_OUTQ_LEN];
+    int fd;
+    int count = wordle_outq_pop(q, msgs, WORDLE_OUTQ_LEN, &fd);
+    if (count == 0 || fd < 0) {
+        return;
     }
-    
+
     httpd_ws_frame_t ws_pkt;
     memset(&ws_pkt, 0, sizeof(httpd_ws_frame_t));
-    ws_pkt.payload = (uint8_t*)message;
-    ws_pkt.len = strlen(message);
+
+    unsigned slot = (unsigned)(fd - LWIP_SOCKET_OFFSET);
+    if (slot < WORDLE_MAX_FDS && binary_fd[slot]) {
+        uint8_t bin[WORDLE_OUTQ_LEN * WORDLE_BIN_MAX_LEN];
+        ws_pkt.payload = bin;
+        ws_pkt.len = wordle_msgs_to_binary(msgs, count, bin);
+        ws_pkt.type = HTTPD_WS_TYPE_BINARY;
+        httpd_ws_send_frame_async(server, fd, &ws_pkt);
+        metrics_frame_out(fd, ws_pkt.len);
+        WORDLE_TRACE(WORDLE_TRACE_FRAME, WORDLE_EV_WS_TX, fd, count, ws_pkt.len);
+        return;
+    }
+
+    char *msg_str = wordle_msgs_to_json(msgs, count);
+    if (msg_str == NULL) {
+        ESP_LOGE(TAG, "Failed to serialize %d messages for fd %d", count, fd);
+        return;
+    }
+
+    ws_pkt.payload = (uint8_t*)msg_str;
+    ws_pkt.len = strlen(msg_str);
     ws_pkt.type = HTTPD_WS_TYPE_TEXT;
-    
+
     // Send the message using the player's file descriptor
-    httpd_ws_send_frame_async(server, game.players[player_index].fd, &ws_pkt);
-    
-    ESP_LOGI(TAG, "Sent to player %d: %s", player_index + 1, message);
+    httpd_ws_send_frame_async(server, fd, &ws_pkt);
+    metrics_frame_out(fd, ws_pkt.len);
+    WORDLE_TRACE(WORDLE_TRACE_FRAME, WORDLE_EV_WS_TX, fd, count, ws_pkt.len);
+    cJSON_free(msg_str);
 }
 
-// Broadcast a message to all connected players
-static void broadcast_to_all(const char *message)
+// Write queued frames to *fd, dropping each reference once sent. The fd is
+// read after each pop: game_task publishes it before queueing, and frames
+// popped while it is -1 are only dropped.
+static void send_frames(wordle_frameq_t *q, const int *dest)
 {
-    ESP_LOGI(TAG, "Broadcasting: %s", message);
-    for (int i = 0; i < 2; i++) {
-        if (game.players[i].connected) {
-            send_to_player(i, message);
+    wordle_frame_t *frame;
+    while ((frame = wordle_frameq_pop(q)) != NULL) {
+        int fd = *dest;
+        if (fd >= 0) {
+            httpd_ws_frame_t ws_pkt;
+            memset(&ws_pkt, 0, sizeof(httpd_ws_frame_t));
+            ws_pkt.payload = frame->data;
+            ws_pkt.len = frame->len;
+            ws_pkt.type = frame->binary ? HTTPD_WS_TYPE_BINARY : HTTPD_WS_TYPE_TEXT;
+            httpd_ws_send_frame_async(server, fd, &ws_pkt);
+            metrics_frame_out(fd, ws_pkt.len);
+            WORDLE_TRACE(WORDLE_TRACE_FRAME, WORDLE_EV_WS_TX, fd, 1, ws_pkt.len);
         }
+        wordle_frame_unref(frame);
     }
 }
 
-// Initialize a new round
-static void start_new_round(void)
+// Owns all socket writes to players. A phone that stops reading can block
+// here for up to send_wait_timeout, but never inside the game logic.
+static void sender_task(void *pvParameters)
 {
-    game.round_number++;
-    game.round_over = false;
-    game.round_start_time = time(NULL);
-    
-    // Reset player states for new round
-    for (int i = 0; i < 2; i++) {
-        if (game.players[i].connected) {
-            game.players[i].guesses_used = 0;
-            game.players[i].has_won = false;
-            game.players[i].waiting_for_opponent = false;  
+    sender_event_t events[SENDER_EVENTS];
+    while (1) {
+        // Collect the finished events first: all of their messages are queued
+        // already, so this pass sends them
+        int count = 0;
+        xQueueReceive(sender_events, &events[count++], portMAX_DELAY);
+        while (count < SENDER_EVENTS && xQueueReceive(sender_events, &events[count], 0) == pdTRUE) {
+            count++;
+        }
+
+        for (int r = 0; r < WORDLE_MAX_ROOMS; r++) {
+            for (int p = 0; p < WORDLE_MAX_PLAYERS; p++) {
+                send_frames(&resume_frames[r][p], &outq[r][p].fd);
+                send_queued(&outq[r][p]);
+            }
+        }
+        for (int s = 0; s < MAX_SPECTATORS; s++) {
+            send_frames(&spectators[s].frames, &spectators[s].fd);
+            send_queued(&spectators[s].msgs);
+        }
+
+        // Nothing from this pass is still being written, and every queue
+        // holding these fds was reset before they were posted, so no later
+        // pass can send to one after lwIP hands the number out again
+        int fd;
+        while (xQueueReceive(sender_closes, &fd, 0) == pdTRUE) {
+            close(fd);  // We own closing once close_fn is set
+        }
+
+        int64_t now = esp_timer_get_time();
+        for (int i = 0; i < count; i++) {
+            metrics_event_done(events[i].type, now - events[i].start_us);
         }
     }
-    
-    // Pick a random word from the list
-    srand(time(NULL) + game.round_number);
-    int random_index = rand() % WORD_LIST_SIZE;
-    strcpy(game.target_word, WORD_LIST[random_index]);
-    
-    ESP_LOGI(TAG, "Round %d started! Target word: %s", game.round_number, game.target_word);
+}
 
-     // Calculate hints based on CURRENT scores and NEW word
-    int score_diff = abs(game.players[0].score - game.players[1].score);
-    int losing_player = -1;
-    
-    if (game.players[0].score < game.players[1].score) {
-        losing_player = 0;
-    } else if (game.players[1].score < game.players[0].score) {
-        losing_player = 1;
+// Value of key in the handshake URL's query string. False when absent.
+static bool query_value(httpd_req_t *req, const char *key, char *out, size_t out_len)
+{
+    char query[64];
+    return httpd_req_get_url_query_str(req, query, sizeof(query)) == ESP_OK &&
+           httpd_query_key_value(query, key, out, out_len) == ESP_OK;
+}
+
+// True when the handshake URL carries proto=bin
+static bool wants_binary(httpd_req_t *req)
+{
+    char proto[8];
+    return query_value(req, "proto", proto, sizeof(proto)) && strcmp(proto, "bin") == 0;
+}
+
+// Session token from a reconnecting page (/ws?token=N), 0 when there is none
+static uint32_t session_token(httpd_req_t *req)
+{
+    char token[12];
+    if (!query_value(req, "token", token, sizeof(token))) {
+        return 0;
     }
-    
-    // Send round start message to both players
-    cJSON *msg = cJSON_CreateObject();
-    cJSON_AddStringToObject(msg, "type", "round_start");
-    cJSON_AddNumberToObject(msg, "round", game.round_number);
-    cJSON_AddNumberToObject(msg, "time_limit", 45);
-    
-     // Add hint for losing player (from NEW word)
-    if (losing_player >= 0 && score_diff >= 2) {
-        int hint_position = rand() % 5;
-        char hint_letter = game.target_word[hint_position];
-        
-        cJSON_AddNumberToObject(msg, "hint_player", losing_player);
-        cJSON_AddNumberToObject(msg, "hint_position", hint_position);
-        cJSON_AddStringToObject(msg, "hint_letter", (char[]){hint_letter, '\0'});
-        
-        if (score_diff >= 4) {
-            cJSON_AddStringToObject(msg, "hint_type", "green");
-        } else {
-            cJSON_AddStringToObject(msg, "hint_type", "yellow");
+    return (uint32_t)strtoul(token, NULL, 10);
+}
+
+// Word length a player asks for (/ws?len=N), NULL for the default or a length
+// this build does not have
+static const wordle_variant_t *length_query(httpd_req_t *req)
+{
+    char len[4];
+    if (!query_value(req, "len", len, sizeof(len))) {
+        return NULL;
+    }
+    return wordle_variant_get(atoi(len));
+}
+
+// The room a handshake asks to watch (/ws?watch=N), -1 for a player.
+// WATCH_ANY without a valid N: game_task picks the first room with a game on.
+static int watch_query(httpd_req_t *req)
+{
+    char room[8];
+    if (!query_value(req, "watch", room, sizeof(room))) {
+        return -1;
+    }
+    char *end;
+    long r = strtol(room, &end, 10);
+    if (end != room && *end == '\0' && r >= 0 && r < WORDLE_MAX_ROOMS) {
+        return (int)r;
+    }
+    return WATCH_ANY;
+}
+
+static int first_active_room(void)
+{
+    for (int i = 0; i < WORDLE_MAX_ROOMS; i++) {
+        if (game_server.rooms[i].game_active) {
+            return i;
         }
-        
-        ESP_LOGI(TAG, "Giving hint to player %d for new word '%s': letter '%c' at position %d (%s)", 
-                 losing_player + 1, game.target_word, hint_letter, hint_position, 
-                 (score_diff >= 4) ? "green" : "yellow");
     }
+    return 0;
+}
 
-    char *msg_str = cJSON_Print(msg);
-    broadcast_to_all(msg_str);
-    
-    free(msg_str);
-    cJSON_Delete(msg);
+static spectator_t *find_spectator(int fd)
+{
+    for (int s = 0; s < MAX_SPECTATORS; s++) {
+        if (spectators[s].fd == fd) {
+            return &spectators[s];
+        }
+    }
+    return NULL;
 }
 
-// End the current round and determine winner
-static void end_round(void)
+// Seat a spectator and queue the room as it stands, so someone arriving
+// mid-round sees both boards before the next event
+static esp_err_t spectator_open(int fd, int r, bool binary)
 {
-    if (game.round_over) return; // Already ended
-    
-    game.round_over = true;
-    
-    ESP_LOGI(TAG, "Round %d ended!", game.round_number);
-    
-    // Determine winner(s)
-    int winner = -1;  // -1 = tie/no winner, 0 = player 1, 1 = player 2
-    
-    // Check if anyone won
-    bool p1_won = game.players[0].connected && game.players[0].has_won;
-    bool p2_won = game.players[1].connected && game.players[1].has_won;
-    
-    if (p1_won && p2_won) {
-        // Both won - check who used fewer guesses
-        if (game.players[0].guesses_used < game.players[1].guesses_used) {
-            winner = 0;
-            game.players[0].score++;
-        } else if (game.players[1].guesses_used < game.players[0].guesses_used) {
-            winner = 1;
-            game.players[1].score++;
-        } else {
-            winner = -1; // Tie - same number of guesses
+    spectator_t *spec = find_spectator(-1);
+    if (spec == NULL) {
+        ESP_LOGW(TAG, "Spectator slots full, refusing fd %d", fd);
+        return ESP_FAIL;
+    }
+    game_state_t *room = &game_server.rooms[r];
+    wordle_frameq_clear(&spec->frames);
+    spec->room = r;
+    spec->binary = binary;
+
+    wordle_frame_t *snapshot = NULL;
+    if (binary) {
+        snapshot = wordle_frame_alloc(WORDLE_BIN_SNAPSHOT_MAX, true);
+        if (snapshot != NULL) {
+            snapshot->len = wordle_snapshot_to_binary(room, -1, snapshot->data);
+        }
+    } else {
+        char *str = wordle_snapshot_to_json(room, -1);
+        if (str != NULL) {
+            size_t len = strlen(str);
+            snapshot = wordle_frame_alloc(len, false);
+            if (snapshot != NULL) {
+                memcpy(snapshot->data, str, len);
+            }
+            cJSON_free(str);
         }
-    } else if (p1_won) {
-        winner = 0;
-        game.players[0].score++;
-    } else if (p2_won) {
-        winner = 1;
-        game.players[1].score++;
     }
-    
-    // Send round results to both players
-    cJSON *msg = cJSON_CreateObject();
-    cJSON_AddStringToObject(msg, "type", "round_end");
-    cJSON_AddNumberToObject(msg, "winner", winner);
-    cJSON_AddStringToObject(msg, "target_word", game.target_word);
-    cJSON_AddNumberToObject(msg, "player1_score", game.players[0].score);
-    cJSON_AddNumberToObject(msg, "player2_score", game.players[1].score);
+    if (snapshot == NULL) {
+        ESP_LOGE(TAG, "Failed to build snapshot for fd %d", fd);
+        return ESP_ERR_NO_MEM;
+    }
 
-    char *msg_str = cJSON_Print(msg);
-    broadcast_to_all(msg_str);
-    free(msg_str);
-    cJSON_Delete(msg);
+    // Publish the fd before queueing: sender_task drops whatever it pops
+    // from a slot whose fd is still -1
+    spec->fd = fd;
+    wordle_outq_reset(&spec->msgs, fd);
+    watchers[r]++;
+    wordle_frameq_push(&spec->frames, snapshot);
+    wordle_frame_unref(snapshot);
+    ESP_LOGI(TAG, "fd %d watching room %d (%d spectators)", fd, r, watchers[r]);
+    return ESP_OK;
 }
 
+// Empty the queues while the fd is still published, so the slot is clean by
+// the time find_spectator(-1) can hand it out again. sender_task may pop
+// some of these frames itself first; either way each is unreffed once.
+static void spectator_close(spectator_t *spec)
+{
+    watchers[spec->room]--;
+    wordle_frameq_clear(&spec->frames);
+    wordle_outq_reset(&spec->msgs, -1);
+    spec->fd = -1;
+}
+
+
+// Engine deadline hook: (re)arm or cancel the room's turn timer
+static void arm_turn_deadline(void *ctx, game_state_t *game, uint32_t delay_ms)
+{
+    int r = game - game_server.rooms;
+    esp_timer_stop(turn_timers[r]);  // Fails harmlessly when it isn't running
+    if (delay_ms == 0) {
+        turn_deadline_us[r] = 0;
+        return;
+    }
+    turn_deadline_us[r] = esp_timer_get_time() + (int64_t)delay_ms * 1000;
+    esp_timer_start_once(turn_timers[r], (uint64_t)delay_ms * 1000);
+}
+
+// Hand an event to game_task. Waits while the queue is full: game_task never
+// blocks on anything but this queue, so the wait is short, and nothing that
+// changes the game is ever dropped.
+static void game_post(const game_event_t *event)
+{
+    xQueueSend(game_events, event, portMAX_DELAY);
+}
+
+// game_task: the turn is over, unless the deadline moved since the timer fired
+static void turn_deadline_event(int r, int64_t start_us)
+{
+    if (turn_deadline_us[r] == 0 || start_us < turn_deadline_us[r]) {
+        return;  // Re-armed or cancelled after the timer fired
+    }
+    turn_deadline_us[r] = 0;
+    wordle_handle_deadline(&game_server.rooms[r]);
+    sender_kick(METRICS_EV_DEADLINE, start_us);
+}
+
+// esp_timer task: hand the expiry to game_task
+static void turn_timer_expired(void *arg)
+{
+    game_event_t event = { .type = GAME_EV_DEADLINE, .room = (intptr_t)arg, .start_us = esp_timer_get_time() };
+    game_post(&event);
+}
+
+// game_task: round 1, unless the room emptied or moved on meanwhile
+static void first_round_event(int r, int64_t start_us)
+{
+    if (wordle_start_first_round(&game_server.rooms[r])) {
+        sender_kick(METRICS_EV_NEXT_ROUND, start_us);
+    }
+}
+
+static void first_round_timer_expired(void *arg)
+{
+    game_event_t event = { .type = GAME_EV_FIRST_ROUND, .room = (intptr_t)arg, .start_us = esp_timer_get_time() };
+    game_post(&event);
+}
+
+// Pool usage, logged when a room empties so the block counts can be sized
+static void log_pool_stats(void)
+{
+    wordle_pool_stats_t stats;
+    wordle_pool_get_stats(&stats);
+    for (int c = 0; c < WORDLE_POOL_CLASSES; c++) {
+        const wordle_pool_class_stats_t *cs = &stats.classes[c];
+        ESP_LOGI(TAG, "pool %3u B: %u/%u in use, high water %u, %lu allocs",
+                 cs->block_size, cs->in_use, cs->blocks, cs->high_water, (unsigned long)cs->allocs);
+    }
+    ESP_LOGI(TAG, "pool fallbacks: %lu (largest %lu B)",
+             (unsigned long)stats.fallbacks, (unsigned long)stats.fallback_max);
+}
+
+// game_task: the grace period is over, free the seat unless it was reclaimed
+static void hold_expired_event(int r, int slot, int64_t start_us)
+{
+    int rooms_before = game_server.rooms_in_use;
+    wordle_server_release(&game_server, &game_server.rooms[r], slot, hold_token[r][slot]);
+    if (game_server.rooms_in_use < rooms_before) {
+        log_pool_stats();
+    }
+    sender_kick(METRICS_EV_OTHER, start_us);
+}
+
+static void hold_timer_expired(void *arg)
+{
+    game_event_t event = {
+        .type = GAME_EV_HOLD_EXPIRED,
+        .room = (intptr_t)arg >> 1,
+        .slot = (intptr_t)arg & 1,
+        .start_us = esp_timer_get_time(),
+    };
+    game_post(&event);
+}
+
+// Start the grace period for a seat that was just held
+static void hold_seat(int r, int slot)
+{
+    hold_token[r][slot] = game_server.rooms[r].players[slot].token;
+    esp_timer_stop(hold_timers[r][slot]);
+    esp_timer_start_once(hold_timers[r][slot], (uint64_t)WORDLE_RECONNECT_GRACE_MS * 1000);
+}
+
+static void turn_timers_init(void)
+{
+    for (int r = 0; r < WORDLE_MAX_ROOMS; r++) {
+        esp_timer_create_args_t args = {
+            .callback = turn_timer_expired,
+            .arg = (void *)(intptr_t)r,
+            .dispatch_method = ESP_TIMER_TASK,
+            .name = "turn",
+        };
+        ESP_ERROR_CHECK(esp_timer_create(&args, &turn_timers[r]));
+
+        esp_timer_create_args_t first_args = {
+            .callback = first_round_timer_expired,
+            .arg = (void *)(intptr_t)r,
+            .dispatch_method = ESP_TIMER_TASK,
+            .name = "first_round",
+        };
+        ESP_ERROR_CHECK(esp_timer_create(&first_args, &first_round_timers[r]));
+
+        for (int p = 0; p < WORDLE_MAX_PLAYERS; p++) {
+            esp_timer_create_args_t hold_args = {
+                .callback = hold_timer_expired,
+                .arg = (void *)(intptr_t)(r << 1 | p),
+                .dispatch_method = ESP_TIMER_TASK,
+                .name = "hold",
+            };
+            ESP_ERROR_CHECK(esp_timer_create(&hold_args, &hold_timers[r][p]));
+        }
+    }
+    wordle_server_set_deadline(&game_server, arm_turn_deadline, NULL);
+}
 
-// Check if 45 seconds have passed since round start
-// static bool is_time_up(void)
-// {
-//     if (!game.game_active || game.round_over) return false;
-    
-//     time_t current_time = time(NULL);
-//     double elapsed = difftime(current_time, game.round_start_time);
-    
-//     return elapsed >= 45.0;
-// }
-
-// Task that checks if round time has expired
-// static void timer_check_task(void *pvParameters)
-// {
-//     while (1) {
-//         vTaskDelay(1000 / portTICK_PERIOD_MS);
-        
-//         if (game.game_active && !game.round_over && game.round_start_time > 0) {
-//             time_t current_time = time(NULL);
-//             double elapsed = difftime(current_time, game.round_start_time);
-            
-//             // Check if 45 seconds passed
-//             if (elapsed >= 45.0) {
-//                 ESP_LOGI(TAG, "Guess timer expired!");
-                
-//                 // Force submit for any player who hasn't guessed
-//                 bool anyone_timeout = false;
-//                 for (int i = 0; i < 2; i++) {
-//                     if (game.players[i].connected && 
-//                         !game.players[i].waiting_for_opponent &&
-//                         !game.players[i].has_won) {
-                        
-//                         ESP_LOGI(TAG, "Player %d timed out", i + 1);
-//                         game.players[i].waiting_for_opponent = true;
-//                         anyone_timeout = true;
-                        
-//                         // Notify that player they timed out
-//                         cJSON *timeout_msg = cJSON_CreateObject();
-//                         cJSON_AddStringToObject(timeout_msg, "type", "timeout");
-//                         char *timeout_str = cJSON_Print(timeout_msg);
-//                         send_to_player(i, timeout_str);
-//                         free(timeout_str);
-//                         cJSON_Delete(timeout_msg);
-//                     }
-//                 }
-                
-//                 if (anyone_timeout) {
-//                     // Reset flags and continue
-//                     game.players[0].waiting_for_opponent = false;
-//                     game.players[1].waiting_for_opponent = false;
-                    
-//                     // Check if round should end
-//                     if (game.players[0].guesses_used >= 5 && game.players[1].guesses_used >= 5) {
-//                         end_round();
-//                     } else {
-//                         // Broadcast to continue
-//                         cJSON *continue_msg = cJSON_CreateObject();
-//                         cJSON_AddStringToObject(continue_msg, "type", "both_guessed");
-//                         char *continue_str = cJSON_Print(continue_msg);
-//                         broadcast_to_all(continue_str);
-//                         free(continue_str);
-//                         cJSON_Delete(continue_msg);
-//                     }
-                    
-//                     // Reset timer for next guess
-//                     game.round_start_time = time(NULL);
-//                 }
-//             }
-//         }
-//     }
-// }
 
 
 
@@ -435,63 +871,319 @@ static void end_round(void)
 
 // +++++++++++++++++++++++++++++++++ Websocket +++++++++++++++++++++++++++++++++++++
 
-// Find a free player slot and add the connection
-static int add_player(int fd)
+// game_task: play the bot's guess if the bot is still seated
+static void bot_guess_event(int r, wordle_word_t guess, int word_len, int64_t start_us)
+{
+    game_state_t *room = &game_server.rooms[r];
+    int slot = wordle_find_player(room, WORDLE_BOT_FD(r));
+    if (slot < 0) {
+        return;
+    }
+    wordle_handle_packed_guess(room, slot, guess, word_len);
+    sender_kick(METRICS_EV_GUESS, start_us);
+}
+
+// Bot task: hand the guess to game_task
+static void bot_submit(int room, wordle_word_t guess, int word_len)
 {
-    for (int i = 0; i < 2; i++) {
-        if (!game.players[i].connected) {
-            game.players[i].fd = fd;
-            game.players[i].connected = true;
-            game.player_count++;
-            ESP_LOGI(TAG, "Player %d joined. Total players: %d", i + 1, game.player_count);
-            return i;  // Return player index (0 or 1)
+    game_event_t event = {
+        .type = GAME_EV_BOT_GUESS,
+        .room = room,
+        .start_us = esp_timer_get_time(),
+        .bot_guess = { guess, (uint8_t)word_len },
+    };
+    game_post(&event);
+}
+
+// Queue a JSON string as a text frame, taking ownership of str
+static bool push_json_frame(wordle_frameq_t *q, char *str)
+{
+    if (str == NULL) {
+        return false;
+    }
+    size_t len = strlen(str);
+    wordle_frame_t *frame = wordle_frame_alloc(len, false);
+    if (frame != NULL) {
+        memcpy(frame->data, str, len);
+    }
+    cJSON_free(str);
+    if (frame == NULL) {
+        return false;
+    }
+    bool queued = wordle_frameq_push(q, frame);
+    wordle_frame_unref(frame);
+    return queued;
+}
+
+// Welcome a player back into its held seat: the new token and a snapshot of
+// the room from its side, in one frame (two for JSON). Queued for sender_task,
+// which writes it before anything the seat's outq gathers from now on.
+static esp_err_t send_resume(game_state_t *room, int slot, int fd, bool binary)
+{
+    int r = room - game_server.rooms;
+    wordle_frameq_t *q = &resume_frames[r][slot];
+    esp_timer_stop(hold_timers[r][slot]);
+    wordle_frameq_clear(q);
+    wordle_outq_reset(&outq[r][slot], fd);
+
+    wordle_msg_t welcome = { .type = WORDLE_MSG_WELCOME };
+    welcome.welcome.player_index = slot;
+    welcome.welcome.token = room->players[slot].token;
+    welcome.welcome.resumed = true;
+
+    if (binary) {
+        wordle_frame_t *frame = wordle_frame_alloc(WORDLE_BIN_MAX_LEN + WORDLE_BIN_SNAPSHOT_MAX, true);
+        if (frame == NULL) {
+            return ESP_ERR_NO_MEM;
         }
+        frame->len = wordle_msg_to_binary(&welcome, frame->data);
+        frame->len += wordle_snapshot_to_binary(room, slot, frame->data + frame->len);
+        bool queued = wordle_frameq_push(q, frame);
+        wordle_frame_unref(frame);
+        return queued ? ESP_OK : ESP_FAIL;
+    }
+
+    if (!push_json_frame(q, wordle_msg_to_json(&welcome)) ||
+        !push_json_frame(q, wordle_snapshot_to_json(room, slot))) {
+        return ESP_ERR_NO_MEM;
     }
-    return -1;  // No slots available
+    return ESP_OK;
 }
 
-// Remove a player when they disconnect
-static void remove_player(int fd)
+// game_task: seat a new connection as a spectator, back in its held seat or
+// in a new one. One that cannot be seated is closed.
+static void open_event(const game_event_t *event)
 {
-    for (int i = 0; i < 2; i++) {
-        if (game.players[i].connected && game.players[i].fd == fd) {
-            game.players[i].connected = false;
-            game.player_count--;
-            ESP_LOGI(TAG, "Player %d left. Total players: %d", i + 1, game.player_count);
-            
-            // If a player leaves, end the game
-            if (game.game_active) {
-                game.game_active = false;
-                ESP_LOGI(TAG, "Game ended because player left");
+    int fd = event->fd;
+    if (event->open.watch != -1) {
+        int r = event->open.watch == WATCH_ANY ? first_active_room() : event->open.watch;
+        if (spectator_open(fd, r, event->open.binary) != ESP_OK) {
+            httpd_sess_trigger_close(server, fd);
+            return;
+        }
+        sender_kick(METRICS_EV_CONNECT, event->start_us);
+        return;
+    }
+
+    // A page that had a seat tries to take it back before asking for a new one
+    int player_index;
+    game_state_t *room = wordle_server_resume(&game_server, fd, event->open.token, &player_index);
+    if (room != NULL) {
+        if (send_resume(room, player_index, fd, event->open.binary) != ESP_OK) {
+            httpd_sess_trigger_close(server, fd);
+        }
+        sender_kick(METRICS_EV_CONNECT, event->start_us);
+        return;
+    }
+
+    room = wordle_server_connect(&game_server, fd, event->open.variant, &player_index);
+    if (room == NULL) {
+        ESP_LOGE(TAG, "All rooms full! Cannot accept more players");
+        httpd_sess_trigger_close(server, fd);
+        return;
+    }
+    wordle_outq_reset(&outq[room - game_server.rooms][player_index], fd);
+    wordle_send_welcome(room, player_index);
+    sender_kick(METRICS_EV_CONNECT, event->start_us);
+}
+
+// game_task: a connection was moved out of seat (r, slot) to make way for the
+// bot. Its queue follows it and it is welcomed in the new room.
+static void reseat(int fd, int r, int slot)
+{
+    wordle_outq_reset(&outq[r][slot], -1);
+    int to;
+    game_state_t *room = wordle_server_lookup(&game_server, fd, &to);
+    if (room != NULL) {
+        wordle_outq_reset(&outq[room - game_server.rooms][to], fd);
+        wordle_send_welcome(room, to);
+    }
+}
+
+// game_task: a player's message. Spectators are read-only, whatever they
+// send is dropped.
+static void player_event(const game_event_t *event)
+{
+    int slot;
+    game_state_t *room = wordle_server_lookup(&game_server, event->fd, &slot);
+    if (room == NULL) {
+        if (find_spectator(event->fd) == NULL) {
+            ESP_LOGE(TAG, "Could not find player for fd %d", event->fd);
+        }
+        return;
+    }
+
+    metrics_event_t type = METRICS_EV_OTHER;
+    switch (event->type) {
+    case GAME_EV_GUESS:
+        type = METRICS_EV_GUESS;
+        if (event->guess.ok) {
+            wordle_handle_packed_guess(room, slot, event->guess.packed, event->guess.word_len);
+        } else {
+            wordle_handle_guess(room, slot, event->guess.text);
+        }
+        break;
+    case GAME_EV_NEXT_ROUND:
+        type = METRICS_EV_NEXT_ROUND;
+        wordle_handle_next_round(room);
+        break;
+    case GAME_EV_JOIN:
+        type = METRICS_EV_JOIN;
+        if (event->join.bot) {
+            // Single player: the bot takes the other seat unless someone
+            // already joined there
+            int moved;
+            wordle_server_add_bot(&game_server, room, slot, &moved);
+            if (moved >= 0) {
+                reseat(moved, room - game_server.rooms, 1 - slot);
             }
+        }
+        if (wordle_handle_join(room, slot, event->join.name)) {
+            // Round 1 after a short pause, on a timer so nothing waits for it
+            esp_timer_handle_t timer = first_round_timers[room - game_server.rooms];
+            esp_timer_stop(timer);
+            esp_timer_start_once(timer, (uint64_t)FIRST_ROUND_DELAY_MS * 1000);
+        }
+        break;
+    default:
+        break;
+    }
+    sender_kick(type, event->start_us);
+}
+
+// game_task: a socket went away, including LRU purges. Its queues are reset
+// here, but sender_task may have popped a frame for it already and be about
+// to write it, so the fd is handed to sender_task to close after that pass.
+static void close_event(int sockfd, int64_t start_us)
+{
+    int seat;
+    game_state_t *room = wordle_server_lookup(&game_server, sockfd, &seat);
+    if (room != NULL) {
+        wordle_outq_reset(&outq[room - game_server.rooms][seat], -1);
+    }
+    spectator_t *spec = find_spectator(sockfd);
+    if (spec != NULL) {
+        spectator_close(spec);
+    }
+
+    int rooms_before = game_server.rooms_in_use;
+    if (wordle_server_disconnect(&game_server, sockfd, WORDLE_RECONNECT_GRACE_MS > 0)) {
+        hold_seat(room - game_server.rooms, seat);
+    }
+    if (game_server.rooms_in_use < rooms_before) {
+        log_pool_stats();
+    }
+
+    unsigned slot = (unsigned)(sockfd - LWIP_SOCKET_OFFSET);
+    if (slot < WORDLE_MAX_FDS) {
+        binary_fd[slot] = false;
+        fd_accepts[slot] = 0;
+    }
+    metrics_conn_close(sockfd);
+    xQueueSend(sender_closes, &sockfd, 0);
+    sender_kick(METRICS_EV_OTHER, start_us);
+}
+
+// Owns game_server: every change to a room happens here, one event at a time,
+// so the engine needs no locks and httpd only ever waits on its sockets
+static void game_task(void *pvParameters)
+{
+    game_event_t event;
+    while (1) {
+        xQueueReceive(game_events, &event, portMAX_DELAY);
+        switch (event.type) {
+        case GAME_EV_OPEN:
+            open_event(&event);
+            break;
+        case GAME_EV_JOIN:
+        case GAME_EV_GUESS:
+        case GAME_EV_NEXT_ROUND:
+            player_event(&event);
+            break;
+        case GAME_EV_CLOSE:
+            close_event(event.fd, event.start_us);
+            break;
+        case GAME_EV_DEADLINE:
+            turn_deadline_event(event.room, event.start_us);
+            break;
+        case GAME_EV_FIRST_ROUND:
+            first_round_event(event.room, event.start_us);
+            break;
+        case GAME_EV_HOLD_EXPIRED:
+            hold_expired_event(event.room, event.slot, event.start_us);
+            break;
+        case GAME_EV_BOT_GUESS:
+            bot_guess_event(event.room, event.bot_guess.packed, event.bot_guess.word_len, event.start_us);
             break;
         }
     }
 }
 
-// WebSocket handler - called when WebSocket receives a message
+// Turn a client frame into a game event, parsing it in place.
+// ESP_ERR_NOT_FOUND for well-formed messages the game has no use for, or
+// not from this connection in the room's current state.
+static esp_err_t decode_frame(char *text, size_t len, uint8_t accepts, game_event_t *event)
+{
+    wordle_in_msg_t msg;
+    wordle_in_type_t type = wordle_parse_inbound(text, len, &msg);
+    if (type > WORDLE_IN_NONE && !(accepts & ACCEPTS(type))) {
+        metrics_frame_dropped(event->fd, METRICS_DROP_STATE);
+        return ESP_ERR_NOT_FOUND;
+    }
+    switch (type) {
+    case WORDLE_IN_GUESS:
+        event->type = GAME_EV_GUESS;
+        event->guess.ok = msg.word_ok;
+        event->guess.packed = msg.packed;
+        event->guess.word_len = (uint8_t)msg.word_len;
+        strncpy(event->guess.text, msg.word, sizeof(event->guess.text) - 1);
+        event->guess.text[sizeof(event->guess.text) - 1] = '\0';
+        return ESP_OK;
+    case WORDLE_IN_NEXT_ROUND:
+        event->type = GAME_EV_NEXT_ROUND;
+        return ESP_OK;
+    case WORDLE_IN_JOIN:
+        event->type = GAME_EV_JOIN;
+        strncpy(event->join.name, msg.name, sizeof(event->join.name) - 1);
+        event->join.name[sizeof(event->join.name) - 1] = '\0';
+        event->join.bot = msg.bot;
+        return ESP_OK;
+    case WORDLE_IN_NONE:
+        return ESP_ERR_NOT_FOUND;
+    case WORDLE_IN_MALFORMED:
+    default:
+        ESP_LOGE(TAG, "Malformed frame from fd %d, closing", event->fd);
+        metrics_conn_kicked(METRICS_KICK_MALFORMED);
+        return ESP_ERR_INVALID_ARG;
+    }
+}
+
+// WebSocket handler: receives and decodes, the game itself runs on game_task
 static esp_err_t ws_handler(httpd_req_t *req)
 {
-    if (req->method == HTTP_GET) {
-        ESP_LOGI(TAG, "WebSocket handshake done, new connection opened");
-        
-        int fd = httpd_req_to_sockfd(req);
-        int player_index = add_player(fd);
+    int64_t start_us = esp_timer_get_time();
+    int fd = httpd_req_to_sockfd(req);
 
-        if (player_index == -1) {
-            ESP_LOGE(TAG, "Game full! Cannot accept more players");
-            return ESP_FAIL;
+    if (req->method == HTTP_GET) {
+        metrics_conn_open(fd);
+        bool binary = wants_binary(req);
+        int watch = watch_query(req);
+        unsigned slot = (unsigned)(fd - LWIP_SOCKET_OFFSET);
+        if (slot < WORDLE_MAX_FDS) {
+            binary_fd[slot] = binary;
+            wordle_rate_reset(&rx_rate[slot], start_us);
+            // Until game_task seats it: spectators send nothing, a player
+            // anything, since a resumed seat may be mid-round
+            fd_accepts[slot] = watch != -1 ? 0 : ACCEPTS(WORDLE_IN_JOIN) |
+                               ACCEPTS(WORDLE_IN_GUESS) | ACCEPTS(WORDLE_IN_NEXT_ROUND);
         }
-        
-        // Just send welcome message - that's it!
-        cJSON *welcome = cJSON_CreateObject();
-        cJSON_AddStringToObject(welcome, "type", "welcome");
-        cJSON_AddNumberToObject(welcome, "player_index", player_index);
-        char *welcome_str = cJSON_Print(welcome);
-        send_to_player(player_index, welcome_str);
-        free(welcome_str);
-        cJSON_Delete(welcome);
-        
+
+        game_event_t event = { .type = GAME_EV_OPEN, .fd = fd, .start_us = start_us };
+        event.open.binary = binary;
+        event.open.watch = watch;
+        event.open.token = session_token(req);
+        event.open.variant = length_query(req);
+        game_post(&event);
         return ESP_OK;
     }
     
@@ -506,240 +1198,78 @@ static esp_err_t ws_handler(httpd_req_t *req)
         return ret;
     }
     
-    ESP_LOGI(TAG, "Received packet with length %d", ws_pkt.len);
-    
     // If length is 0, nothing to do
-    if (ws_pkt.len) {
-        // Allocate buffer for the message
-        uint8_t *buf = calloc(1, ws_pkt.len + 1);
-        if (buf == NULL) {
-            ESP_LOGE(TAG, "Failed to allocate memory");
-            return ESP_ERR_NO_MEM;
-        }
-        ws_pkt.payload = buf;
-        
-        // Actually receive the message
-        ret = httpd_ws_recv_frame(req, &ws_pkt, ws_pkt.len);
-        if (ret != ESP_OK) {
-            ESP_LOGE(TAG, "httpd_ws_recv_frame failed with %d", ret);
-            free(buf);
-            return ret;
-        }
-        
-        ESP_LOGI(TAG, "Got message: %s", ws_pkt.payload);
-
-        // Parse the JSON message
-        cJSON *json = cJSON_Parse((char*)ws_pkt.payload);
-        if (json == NULL) {
-            ESP_LOGE(TAG, "Failed to parse JSON");
-            free(buf);
-            return ESP_ERR_INVALID_ARG;
-        }
+    if (ws_pkt.len == 0) {
+        return ESP_OK;
+    }
 
-        // Get the message type
-        cJSON *type_item = cJSON_GetObjectItem(json, "type");
-        if (type_item == NULL || !cJSON_IsString(type_item)) {
-            ESP_LOGE(TAG, "No type field in JSON");
-            cJSON_Delete(json);
-            free(buf);
-            return ESP_ERR_INVALID_ARG;
-        }
+    // Returning an error from here makes httpd close the socket
+    if (ws_pkt.len >= WS_RX_BUF_LEN) {
+        ESP_LOGW(TAG, "%u byte frame from fd %d, closing", (unsigned)ws_pkt.len, fd);
+        metrics_conn_kicked(METRICS_KICK_SIZE);
+        return ESP_ERR_INVALID_SIZE;
+    }
 
-        const char *msg_type = type_item->valuestring;
-        ESP_LOGI(TAG, "Message type: %s", msg_type);
-
-        // Handle different message types
-        if (strcmp(msg_type, "guess") == 0) {
-            cJSON *word_item = cJSON_GetObjectItem(json, "word");
-            if (word_item != NULL && cJSON_IsString(word_item)) {
-                const char *guess = word_item->valuestring;
-                
-                // Find which player made this guess
-                int fd = httpd_req_to_sockfd(req);
-                int player_index = -1;
-                for (int i = 0; i < 2; i++) {
-                    if (game.players[i].connected && game.players[i].fd == fd) {
-                        player_index = i;
-                        break;
-                    }
-                }
-                
-                if (player_index == -1) {
-                    ESP_LOGE(TAG, "Could not find player for guess");
-                    cJSON_Delete(json);
-                    free(buf);
-                    return ESP_ERR_INVALID_ARG;
-                }
-                
-                // Check if they're already waiting or round is over
-                if (game.players[player_index].waiting_for_opponent) {
-                    ESP_LOGI(TAG, "Player %d already submitted, waiting for opponent", player_index + 1);
-                    cJSON_Delete(json);
-                    free(buf);
-                    return ESP_OK;
-                }
-                
-                if (game.round_over || game.players[player_index].has_won) {
-                    ESP_LOGI(TAG, "Player %d tried to guess but round is over or they won", player_index + 1);
-                    cJSON_Delete(json);
-                    free(buf);
-                    return ESP_OK;
-                }
-                
-                ESP_LOGI(TAG, "Player %d guessed: %s", player_index + 1, guess);
-                
-                game.players[player_index].guesses_used++;
-                game.players[player_index].waiting_for_opponent = true;
-                
-                // Check the guess
-                int result[5];
-                check_guess(guess, game.target_word, result);
-                
-                bool is_correct = true;
-                for (int i = 0; i < 5; i++) {
-                    if (result[i] != 2) {
-                        is_correct = false;
-                        break;
-                    }
-                }
-                
-                if (is_correct) {
-                    game.players[player_index].has_won = true;
-                    ESP_LOGI(TAG, "Player %d won the round!", player_index + 1);
-                }
-                
-                // Send result to this player
-                cJSON *response = cJSON_CreateObject();
-                cJSON_AddStringToObject(response, "type", "result");
-                cJSON_AddStringToObject(response, "word", guess);
-                cJSON_AddNumberToObject(response, "player", player_index);
-                cJSON *result_array = cJSON_CreateIntArray(result, 5);
-                cJSON_AddItemToObject(response, "result", result_array);
-                cJSON_AddBoolToObject(response, "is_correct", is_correct);
-                
-                char *response_str = cJSON_Print(response);
-                send_to_player(player_index, response_str);
-                free(response_str);
-                cJSON_Delete(response);
-                
-                // Notify opponent that this player submitted
-                int opponent_index = (player_index == 0) ? 1 : 0;
-                cJSON *waiting_msg = cJSON_CreateObject();
-                cJSON_AddStringToObject(waiting_msg, "type", "opponent_submitted");
-                cJSON_AddNumberToObject(waiting_msg, "opponent", player_index);
-                char *waiting_str = cJSON_Print(waiting_msg);
-                send_to_player(opponent_index, waiting_str);
-                free(waiting_str);
-                cJSON_Delete(waiting_msg);
-                
-                // Check if both players have submitted
-                bool both_submitted = game.players[0].waiting_for_opponent && 
-                                    game.players[1].waiting_for_opponent;
-                
-                if (both_submitted) {
-                    ESP_LOGI(TAG, "Both players submitted their guesses");
-                    
-                    // Reset waiting flags for next guess
-                    game.players[0].waiting_for_opponent = false;
-                    game.players[1].waiting_for_opponent = false;
-                    
-                    // Broadcast both results to both players
-                    cJSON *both_results = cJSON_CreateObject();
-                    cJSON_AddStringToObject(both_results, "type", "both_guessed");
-                    char *both_str = cJSON_Print(both_results);
-                    broadcast_to_all(both_str);
-                    free(both_str);
-                    cJSON_Delete(both_results);
-                    
-                    // Check if round should end
-                    if (game.players[0].has_won || game.players[1].has_won) {
-                        end_round();
-                    } else if (game.players[0].guesses_used >= 5 && game.players[1].guesses_used >= 5) {
-                        end_round();
-                    }
-                }
-            }
-        }else if (strcmp(msg_type, "next_round") == 0) {
-            ESP_LOGI(TAG, "Next round requested");
-            
-            if (game.round_over) {
-                start_new_round();
-            } else {
-                ESP_LOGE(TAG, "Cannot start next round - current round not over");
-            }
-        }
-        else if (strcmp(msg_type, "join") == 0) {
-            // Get player name
-            cJSON *name_item = cJSON_GetObjectItem(json, "name");
-            if (name_item != NULL && cJSON_IsString(name_item)) {
-                const char *name = name_item->valuestring;
-                
-                // Find which player this is
-                int fd = httpd_req_to_sockfd(req);
-                int player_index = -1;
-                for (int i = 0; i < 2; i++) {
-                    if (game.players[i].connected && game.players[i].fd == fd) {
-                        player_index = i;
-                        strncpy(game.players[i].name, name, 31);
-                        game.players[i].name[31] = '\0';
-                        ESP_LOGI(TAG, "Player %d (%s) joined the lobby", i + 1, name);
-                        break;
-                    }
-                }
-                
-                if (player_index == -1) {
-                    ESP_LOGE(TAG, "Could not find player");
-                    cJSON_Delete(json);
-                    free(buf);
-                    return ESP_ERR_INVALID_ARG;
-                }
-                
-                // Send lobby update to all players
-                cJSON *lobby_msg = cJSON_CreateObject();
-                cJSON_AddStringToObject(lobby_msg, "type", "lobby_update");
-                cJSON_AddNumberToObject(lobby_msg, "player_count", game.player_count);
-                char *lobby_str = cJSON_Print(lobby_msg);
-                broadcast_to_all(lobby_str);
-                free(lobby_str);
-                cJSON_Delete(lobby_msg);
-                
-                // Check if both players have names (both clicked join)
-                bool both_ready = (strlen(game.players[0].name) > 0 && 
-                                strlen(game.players[1].name) > 0 &&
-                                game.players[0].connected && 
-                                game.players[1].connected);
-                
-                if (both_ready && game.player_count == 2) {
-                    ESP_LOGI(TAG, "Both players ready! Starting game...");
-                    
-                    // Send game_starting message
-                    cJSON *start_msg = cJSON_CreateObject();
-                    cJSON_AddStringToObject(start_msg, "type", "game_starting");
-                    char *start_str = cJSON_Print(start_msg);
-                    broadcast_to_all(start_str);
-                    free(start_str);
-                    cJSON_Delete(start_msg);
-                    
-                    game.game_active = true;
-                    
-                    // Start first round after a short delay
-                    vTaskDelay(1000 / portTICK_PERIOD_MS);
-                    start_new_round();
-                }
-            }
+    // The payload is read either way so the next frame header lines up
+    uint8_t buf[WS_RX_BUF_LEN];
+    ws_pkt.payload = buf;
+    ret = httpd_ws_recv_frame(req, &ws_pkt, ws_pkt.len);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "httpd_ws_recv_frame failed with %d", ret);
+        return ret;
+    }
+    buf[ws_pkt.len] = '\0';
+
+    metrics_frame_in(fd, ws_pkt.len);
+    WORDLE_TRACE(WORDLE_TRACE_FRAME, WORDLE_EV_WS_RX, fd, ws_pkt.len, 0);
+
+    // Over its rate or with nothing to say right now: dropped unparsed
+    unsigned slot = (unsigned)(fd - LWIP_SOCKET_OFFSET);
+    uint8_t accepts = slot < WORDLE_MAX_FDS ? fd_accepts[slot] : 0;
+    if (slot < WORDLE_MAX_FDS && !wordle_rate_allow(&rx_rate[slot], start_us)) {
+        metrics_frame_dropped(fd, METRICS_DROP_RATE);
+        if (wordle_rate_strike(&rx_rate[slot], start_us)) {
+            ESP_LOGW(TAG, "fd %d keeps flooding, closing", fd);
+            metrics_conn_kicked(METRICS_KICK_RATE);
+            return ESP_FAIL;
         }
+        return ESP_OK;
+    }
+    if (accepts == 0) {
+        metrics_frame_dropped(fd, METRICS_DROP_STATE);
+        return ESP_OK;
+    }
 
-        cJSON_Delete(json);
-        free(buf);
+    game_event_t event = { .fd = fd, .start_us = start_us };
+    ret = decode_frame((char *)buf, ws_pkt.len, accepts, &event);
+    if (ret == ESP_OK) {
+        game_post(&event);
+    } else if (ret == ESP_ERR_NOT_FOUND) {
+        ret = ESP_OK;
     }
-    
     return ret;
 }
 
+// Called by httpd whenever a socket goes away; game_task cleans up and
+// sender_task closes it
+static void ws_close_handler(httpd_handle_t hd, int sockfd)
+{
+    game_event_t event = { .type = GAME_EV_CLOSE, .fd = sockfd, .start_us = esp_timer_get_time() };
+    game_post(&event);
+}
+
 static httpd_handle_t start_webserver(void)
 {
     httpd_config_t config = HTTPD_DEFAULT_CONFIG();
     config.lru_purge_enable = true;
+    config.close_fn = ws_close_handler;
+    config.send_wait_timeout = 2;  // Seconds a stalled client can hold up sender_task
+    config.core_id = 0;            // The bot task has the other core
+
+    // Two players per room, the spectators, plus a couple for page loads;
+    // httpd needs 3 of lwIP's sockets for itself
+    config.max_open_sockets = MIN(WORDLE_MAX_ROOMS * WORDLE_MAX_PLAYERS + MAX_SPECTATORS + 2,
+                                  CONFIG_LWIP_MAX_SOCKETS - 3);
 
     ESP_LOGI(TAG, "Starting HTTP server on port: '%d'", config.server_port);
     
@@ -748,27 +1278,51 @@ static httpd_handle_t start_webserver(void)
         httpd_uri_t root = {
             .uri       = "/",
             .method    = HTTP_GET,
-            .handler   = root_get_handler,
-            .user_ctx  = NULL
+            .handler   = asset_get_handler,
+            .user_ctx  = (void *)&index_asset
         };
         httpd_register_uri_handler(server, &root);
 
         httpd_uri_t css = {
             .uri       = "/style.css",
             .method    = HTTP_GET,
-            .handler   = css_get_handler,
-            .user_ctx  = NULL
+            .handler   = asset_get_handler,
+            .user_ctx  = (void *)&css_asset
         };
         httpd_register_uri_handler(server, &css);
 
         httpd_uri_t js = {
             .uri       = "/script.js",
             .method    = HTTP_GET,
-            .handler   = js_get_handler,
-            .user_ctx  = NULL
+            .handler   = asset_get_handler,
+            .user_ctx  = (void *)&js_asset
         };
         httpd_register_uri_handler(server, &js);
 
+        httpd_uri_t trace = {
+            .uri       = "/trace",
+            .method    = HTTP_GET,
+            .handler   = trace_get_handler,
+            .user_ctx  = NULL
+        };
+        httpd_register_uri_handler(server, &trace);
+
+        httpd_uri_t metrics = {
+            .uri       = "/metrics",
+            .method    = HTTP_GET,
+            .handler   = metrics_get_handler,
+            .user_ctx  = NULL
+        };
+        httpd_register_uri_handler(server, &metrics);
+
+        httpd_uri_t leaderboard = {
+            .uri       = "/leaderboard",
+            .method    = HTTP_GET,
+            .handler   = leaderboard_get_handler,
+            .user_ctx  = NULL
+        };
+        httpd_register_uri_handler(server, &leaderboard);
+
         httpd_uri_t ws = {
             .uri       = "/ws",
             .method    = HTTP_GET,
@@ -803,14 +1357,33 @@ void app_main(void)
       ret = nvs_flash_init();
     }
     ESP_ERROR_CHECK(ret);
+    leaderboard_init();
 
     ESP_LOGI(TAG, "ESP_WIFI_MODE_AP");
     wifi_init_softap();
     
     // Start web server
+    wordle_json_use_pool();
+    wordle_server_init(&game_server, LWIP_SOCKET_OFFSET, send_to_fd, NULL);
+    leaderboard_deck_load(game_server.decks);
+    for (int r = 0; r < WORDLE_MAX_ROOMS; r++) {
+        for (int p = 0; p < WORDLE_MAX_PLAYERS; p++) {
+            wordle_outq_reset(&outq[r][p], -1);
+        }
+        wordle_game_set_watch(&game_server.rooms[r], watch_room, NULL);
+    }
+    for (int s = 0; s < MAX_SPECTATORS; s++) {
+        spectators[s].fd = -1;
+        wordle_outq_reset(&spectators[s].msgs, -1);
+    }
+    sender_events = xQueueCreate(SENDER_EVENTS, sizeof(sender_event_t));
+    sender_closes = xQueueCreate(WORDLE_MAX_FDS, sizeof(int));
+    game_events = xQueueCreate(GAME_EVENTS, sizeof(game_event_t));
+    xTaskCreate(sender_task, "ws_sender", 4096, NULL, 5, NULL);
+    // Beside httpd on core 0, the bot's solves have core 1
+    xTaskCreatePinnedToCore(game_task, "game", 4096, NULL, 5, NULL, 0);
+    turn_timers_init();
+    bot_init(bot_submit);
     start_webserver();
     ESP_LOGI(TAG, "Server ready! Connect to WiFi and visit http://192.168.4.1");
-
-    // Start timer check task
-    // xTaskCreate(timer_check_task, "timer_check", 2048, NULL, 5, NULL);
 }
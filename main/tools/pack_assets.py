@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+"""Minify and gzip the web assets for embedding.
+
+For every input writes <name>.gz next to a header, wordle_assets.h, holding
+one ETag per asset. style.css and script.js are served with a long cache
+lifetime, so index.html is rewritten to reference them as /name?v=<etag>:
+a new build changes the URL and browsers fetch the new copy.
+
+    pack_assets.py --out gen index.html style.css script.js
+
+The minifiers are deliberately conservative (comments, indentation and blank
+lines only) so they cannot change what the page does.
+"""
+import argparse
+import gzip
+import hashlib
+import os
+import re
+
+HEADER = '''// Generated by pack_assets.py, do not edit
+#ifndef WORDLE_ASSETS_H
+#define WORDLE_ASSETS_H
+
+{defines}
+
+#endif // WORDLE_ASSETS_H
+'''
+
+
+def minify_html(text):
+    text = re.sub(r'<!--.*?-->', '', text, flags=re.S)
+    lines = (line.strip() for line in text.splitlines())
+    return '\n'.join(line for line in lines if line)
+
+
+def minify_css(text):
+    text = re.sub(r'/\*.*?\*/', '', text, flags=re.S)
+    text = re.sub(r'\s+', ' ', text)
+    text = re.sub(r'\s*([{};,])\s*', r'\1', text)
+    return text.replace(';}', '}').strip()
+
+
+def minify_js(text):
+    # Keep the line structure: the script relies on automatic semicolons
+    out = []
+    for line in text.splitlines():
+        line = line.strip()
+        if line and not line.startswith('//'):
+            out.append(line)
+    return '\n'.join(out)
+
+
+MINIFIERS = {'.html': minify_html, '.css': minify_css, '.js': minify_js}
+
+
+def etag(data):
+    return hashlib.sha1(data).hexdigest()[:16]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('--out', required=True)
+    parser.add_argument('assets', nargs='+')
+    args = parser.parse_args()
+
+    # Sub-resources first, the page embeds their ETags in its URLs
+    assets = sorted(args.assets, key=lambda p: p.endswith('.html'))
+    tags = {}
+    os.makedirs(args.out, exist_ok=True)
+    for path in assets:
+        name = os.path.basename(path)
+        with open(path, encoding='utf-8') as f:
+            text = f.read()
+        text = MINIFIERS[os.path.splitext(name)[1]](text)
+        if name.endswith('.html'):
+            for ref, tag in tags.items():
+                text = text.replace('"/%s"' % ref, '"/%s?v=%s"' % (ref, tag))
+
+        # mtime=0 keeps the output, and so the ETag, reproducible
+        data = gzip.compress(text.encode('utf-8'), compresslevel=9, mtime=0)
+        with open(os.path.join(args.out, name + '.gz'), 'wb') as f:
+            f.write(data)
+        tags[name] = etag(data)
+        print('%s: %d -> %d bytes' % (name, os.path.getsize(path), len(data)))
+
+    defines = '\n'.join(
+        '#define ASSET_ETAG_%s "\\"%s\\""' % (re.sub(r'\W', '_', name).upper(), tag)
+        for name, tag in tags.items())
+    with open(os.path.join(args.out, 'wordle_assets.h'), 'w') as f:
+        f.write(HEADER.format(defines=defines))
+
+
+if __name__ == '__main__':
+    main()
@@ -1,78 +0,0 @@
-#ifndef WORDS_H
-#define WORDS_H
-
-static const char* WORD_LIST[] = {
-    "CRANE","SLATE","AUDIO","THEIR","WORLD","ABOUT","HOUSE","GREAT","THINK","ZEBRA", "ADIEU"
-    "PLACE","ROUND","BROWN","TRIAL","SMART","HEART","BRAIN","CHASE","CLAIM","DANCE","APPLY",
-    "FLAME", "ABIDE", "ADULT", "AFTER", "ALIVE", "ALTER", "AMBER", "ANGER", "ANGLE", "APPLE",  
-    "ARISE", "ASIDE", "ASSET", "AVOID", "AWAKE", "BASIC", "BEACH", "BEGIN", "BLACK", "BLAME", 
-    "BLAST", "BLIND", "BLOCK", "BOARD", "BOOST", "BREAD", "BREAK", "BRICK", "BRIEF", "BRING", 
-    "BROAD", "BRUSH", "BUILD", "BURST", "CANDY", "CATCH", "CAUSE", "CHAIN", "CHAIR", "CHART", 
-    "CHEAP", "CHECK", "CHEEK", "CHEST", "CHIEF", "CHILD", "CLEAN", "CLEAR", "CLOCK", "CLOUD", 
-    "COAST", "COUNT", "COURT", "COVER", "CRAFT", "CREAM", "CROSS", "CROWD", "CROWN", "DAILY", 
-    "DEATH", "DELAY", "DIRTY", "DRESS", "DRIVE", "DRINK", "EARLY", "EARTH", "EMPTY", "ENTRY", 
-    "EQUAL", "ERROR", "EVENT", "EVERY", "EXTRA", "FAITH", "FALSE", "FAULT", "FIELD", "FIGHT", 
-    "FINAL", "FIRST", "FLASH", "FLOAT", "FLOOR", "FOCUS", "FORCE", "FORUM", "FRAME", "FRESH", 
-    "FRONT", "FRUIT", "GHOST", "GLASS", "GLIDE", "GRAND", "GRAPE", "GRASS", "GREEN", "GROUP", 
-    "GUARD", "GUESS", "GUIDE", "HABIT", "HAPPY", "HEAVY", "HOTEL", "IMAGE", "INDEX", "INNER", 
-    "INPUT", "ISSUE", "JOINT", "JUDGE", "JUICE", "KNIFE", "LABOR", "LAYER", "LEARN", "LEAST", 
-    "LEVEL", "LIGHT", "LIMIT", "LOCAL", "LUCKY", "LUNCH", "MAGIC", "MAJOR", "MAKER", "MARCH", 
-    "MATCH", "METAL", "MODEL", "MONEY", "MONTH", "MOTOR", "MOUNT", "MOUSE", "MOVIE", "MUSIC", 
-    "NIGHT", "NOBLE", "NOISE", "NORTH", "NOVEL", "NURSE", "OCEAN", "OFFER", "ORDER", "OTHER", 
-    "PAINT", "PANEL", "PARTY", "PAUSE", "PHASE", "PHONE", "PIANO", "PILOT", "PITCH", "PLANE", 
-    "PLANT", "PLATE", "POINT", "POUND", "POWER", "PRESS", "PRICE", "PRIDE", "PRIOR", "PRIZE", 
-    "PROUD", "PROVE", "QUEEN", "QUICK", "QUIET", "QUITE", "RADIO", "RAISE", "RANGE", "REACH", 
-    "READY", "RELAX", "REPLY", "RIGHT", "SHARE", "SHIFT", "SHINE", "SHIRT", "SHOCK", "SHORE", 
-    "SHORT", "SHOUT", "SIGHT", "SINCE", "SKILL", "SLEEP", "SLICE", "SLIDE", "SMALL", "SMILE", 
-    "SMOKE", "SOUND", "SOUTH", "SPACE", "SPEAK", "SPEND", "SPORT", "STAGE", "STAND", "START", 
-    "VIVID", "SWAMP", "JOKER", "TULIP", "LYRIC", "QUART", "FROZE", "PLUCK", "STOMP", "VOWEL",
-    "SKUNK", "MIGHT", "WRECK", "SNACK", "PIXEL", "JUMPY", "THUMP", "FLICK", "SPOON", "GREET",
-    "SHAKE", "VALVE", "SQUAD", "MERCY", "KNOCK", "STARK", "GRUNT", "PROXY", "TWIST", "SHACK",
-    "GLOOM", "FETCH", "WHALE", "STUMP", "PRICK", "JOLLY", "SWEPT", "VIGOR", "PLUMB", "SCOLD",
-    "BLINK", "TRUNK", "SHAKY", "QUEST", "STIFF", "PRANK", "YACHT", "SWING", "FLOOD", "WRIST",
-    "CHUMP", "STARE", "VOCAL", "BRAWL", "CLERK", "SPOUT", "GRAIN", "TWANG", "SKULL", "MOIST",
-    "GRIMY", "SNEAK", "SPARE", "CLING", "WHEAT", "STORY", "BRUTE", "GULCH", "SNAKE", "PROBE",
-    "WHACK", "SWIFT", "BLARE", "SHUSH", "FLAME", "TRACK", "GLOVE", "SPOIL", "DWARF", "TRAIL",
-    "STRAY", "SMASH", "BLIMP", "SHREW", "QUIRK", "SLUMP", "CHEEK", "GRIME", "STERN", "SHOVE",
-    "FLUNG", "SNOUT", "BRASH", "SWIRL", "PLANK", "STAIN", "GIRTH", "CHURN", "SNORE", "GLAZE",
-    "SLICK", "BIRCH", "STUNG", "PRONE", "BRAVO", "SPARK", "TWICE", "GLARE", "SHARK", "GROVE",
-    "STAMP", "CLASH", "WHISK", "STOUT", "GRAVY", "PLUME", "SNEER", "FLUNK", "STOOL", "PRISM",
-    "BLUNT", "SHEER", "QUAKE", "SLING", "CHOIR", "GRIPH", "STEER", "SHINY", "FLYER", "SNORT",
-    "BRENT", "SWISH", "PLIANT", "STEAD", "GAUGE", "CHAMP", "SNARL", "GLASS", "SLIMY", "CLASP",
-    "WRITE", "SPAWN", "TOAST", "GORGE", "SHUCK", "FLUID", "STUCK", "PRIOR", "BLAST", "SHELF",
-    "QUERY", "SLATE", "CHIDE", "GRATE", "STEEL", "SHORE", "FRISK", "SNOWY", "BRAKE", "SWORE",
-    "PLEAD", "STEAK", "GAUNT", "CHASM", "SNIDE", "GLEAM", "SLOPE", "CLICK", "WROTE", "SPEAR",
-    "THROB", "GRAND", "SHRED", "FLUFF", "STOCK", "PRIVY", "BLEND", "SHIFT", "QUOTA", "SLUSH",
-    "CHIRP", "GRAFT", "STICK", "SHOAL", "FROST", "SNUFF", "BRICK", "SYRUP", "PLUCK", "STEEP",
-    "GAVEL", "CHESS", "SOLAR", "GLOSS", "SLACK", "CLEAN", "WREAK", "SPINE", "THUMB", "GRASP", 
-    "ADMIT", "ADOPT", "ADULT", "AGENT", "AGREE", "ALBUM", "ALLOW", "ALONE", "ALONG", "AMONG", 
-    "AMPLE", "ANGEL", "APART", "APPLE", "AREAS", "ARMOR", "ARRAY", "ARROW", "ASSET", "AUDIO", 
-    "AWFUL", "BASIC", "BASIS", "BEING", "BELOW", "BENCH", "BIBLE", "BIRTH", "BLOCK", "BLOOD", 
-    "BOARD", "BOOKS", "BOUND", "BRAIN", "BREAD", "BREAK", "BRIEF", "BRING", "BROAD", "BROWN", 
-    "BUILD", "BUILT", "BUYER", "CABLE", "CALIF", "CARRY", "CATCH", "CAUSE", "CHAIN", "CHAIR", 
-    "CHART", "CHECK", "CHEST", "CHIEF", "CHILD", "CHINA", "CHOSE", "CIVIL", "CLAIM", "CLASS", 
-    "CLEAN", "CLEAR", "CLOCK", "CLOSE", "COACH", "COAST", "COULD", "COUNT", "COURT", "COVER", 
-    "CRAFT", "CROSS", "CROWD", "CROWN", "CURVE", "CYCLE", "DAILY", "DANCE", "DATES", "DEATH",
-    "DELAY", "DEPTH", "DIRTY", "DOUBT", "DOZEN", "DRAFT", "DRAMA", "DREAD", "DRESS", "DRINK",
-    "DRIVE", "DROVE", "DYING", "EAGER", "EARLY", "EARTH", "EIGHT", "ELITE", "EMPTY", "ENEMY", 
-    "FORTY", "FORUM", "FOUND", "FULLY", "FUNNY", "GIANT", "GIVEN", "GLOVE", "GOING", "GRACE", 
-    "GRADE", "GRAPH", "GROWN", "GUEST", "GUIDE", "HANDY", "HEARD", "HELLO", "HENCE", "HONEY", 
-    "IDEAL", "INDEX", "INNER", "INPUT", "IRONIC", "JOINT", "JUDGE", "KNOWN", "LABEL", "LARGE", 
-    "LATER", "LEARN", "LEGAL", "LEVEL", "LIGHT", "LIMIT", "LOCAL", "LUCKY", "LUNCH", "LYRIC", 
-    "MAGIC", "MAJOR", "MAKER", "MARCH", "MATCH", "METAL", "MONEY", "MONTH", "MOTOR", "MOUNT",
-     "MOUSE", "MOUTH", "MOVIE", "MUSIC", "NEEDS", "NEVER", "NEWLY", "NIGHT", "NOISE", "NORTH", 
-     "NOTED", "NOVEL", "NURSE", "OCEAN", "OFFER", "OFTEN", "ORDER", "OTHER", "OUGHT", "PAINT", 
-     "PANEL", "PAPER", "PARTY", "PEACE", "PETER", "PHASE", "PHONE", "PHOTO", "PIANO", "PIECE", 
-     "PILOT", "PITCH", "PLACE", "PLAIN", "PLANE", "PLANT", "PLATE", "POINT", "POUND", "POWER",
-     "PRESS", "PRICE", "PRIDE", "PRIOR", "PRIZE", "PROOF", "PROUD", "PROVE", "QUEEN", "QUICK", 
-     "QUIET", "QUITE", "RADIO", "RAISE", "RANGE", "RAPID", "RATIO", "REACH", "READY", "REFER", 
-     "RIGHT", "RIVAL", "RIVER", "ROUGH", "ROUND", "ROUTE", "ROYAL", "RURAL", "SCALE", "SCENE", 
-     "SCOPE", "SCORE", "SENSE", "SERVE", "SEVEN", "SHAKE", "SHARE", "SHARP", "SHEET", "SHELF", 
-     "SHELL", "SHIFT", "SHIRT", "SHOCK", "SHOOT", "SHORE", "SHORT", "SHOUT", "SHOWN", "SIGHT", 
-     "SINCE", "SIXTY", "SIZED", "SKILL", "SLEEP", "SLIDE"
-    
-};
-
-#define WORD_LIST_SIZE (sizeof(WORD_LIST) / sizeof(WORD_LIST[0]))
-
-#endif // WORDS_H
\ No newline at end of file